@@ -0,0 +1,75 @@
+// Builds and drops chainTable/LinkedList instances with the
+// default heap allocator, an arena and a pool.
+
+#include "../include/arenaAllocator.h"
+#include "../include/poolAllocator.h"
+#include "../../Hash-Table/Separate-Chaining/include/chainTable.h"
+#include "../../Linked-List/Singly-Linked-List/Regular/include/linkedList.h"
+#include "../../General/benchTimer.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std::chrono;
+
+static void buildTable(const char* name, Allocator* alloc, int n)
+{
+    auto start = steady_clock::now();
+    {
+        chainTable<int, int> table(alloc);
+        for (int i = 0; i < n; i++)
+            table.add(i, i);
+        std::cout << name << " table build: " << elapsed(start) << " ms, ";
+        start = steady_clock::now();
+    }
+    std::cout << "drop: " << elapsed(start) << " ms\n";
+}
+
+static void churnList(const char* name, Allocator* alloc, int n)
+{
+    auto start = steady_clock::now();
+    LinkedList<int> list(alloc);
+    for (int round = 0; round < 10; round++)
+    {
+        for (int i = 0; i < n; i++)
+            list.prepend(i);
+        for (int i = 0; i < n; i++)
+            list.erase(0);
+    }
+    std::cout << name << " list churn: " << elapsed(start) << " ms\n";
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 1000000);
+
+    buildTable("Heap", defaultAllocator(), n);
+    {
+        ArenaAllocator arena(1 << 20);
+        buildTable("Arena", &arena, n);
+    }
+    {
+        PoolAllocator pool(sizeof(ListNode<Entry<int, int>>), 4096);
+        buildTable("Pool", &pool, n);
+    }
+
+    churnList("Heap", defaultAllocator(), n);
+    {
+        PoolAllocator pool(sizeof(ListNode<int>), 4096);
+        churnList("Pool", &pool, n);
+    }
+
+    // The arena can drop a table it also holds in O(1).
+    {
+        using Table = chainTable<int, int>;
+        ArenaAllocator arena(1 << 20);
+        Table* table = new (arena.allocate(sizeof(Table), alignof(Table))) Table(&arena);
+        for (int i = 0; i < n; i++)
+            table->add(i, i);
+        auto start = steady_clock::now();
+        arena.release();
+        std::cout << "Arena release of a placed table: " << elapsed(start) << " ms\n";
+    }
+
+    return 0;
+}
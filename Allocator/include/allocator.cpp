@@ -0,0 +1,3 @@
+#include "allocator.h"
+#include "arenaAllocator.h"
+#include "poolAllocator.h"
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*  Runtime allocator handle shared by every container in this project.
+*   Containers hold an Allocator* (defaultAllocator() unless one is passed in) and route every allocation of their
+*   own storage through it: Array buffers, LinkedList nodes and, through those, every hash table.
+*   The handle travels with the memory: copies and moves keep the allocator of the storage they came from.
+*/
+
+#pragma once
+#include <cstddef>
+#include <new>
+
+class Allocator
+{
+    public:
+        virtual ~Allocator() = default;
+
+        virtual void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) = 0;
+        virtual void deallocate(void* ptr, size_t size, size_t alignment = alignof(std::max_align_t)) = 0;
+
+        // True if deallocate() does nothing and memory is only
+        // given back all at once (like an arena).
+        // Containers use this to skip freeing their nodes one by one.
+        virtual bool releasesInBulk() const;
+};
+
+// Plain new/delete.
+class HeapAllocator : public Allocator
+{
+    public:
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) override;
+        void deallocate(void* ptr, size_t size, size_t alignment = alignof(std::max_align_t)) override;
+};
+
+// The allocator containers use when none is given.
+inline Allocator* defaultAllocator();
+
+inline bool Allocator::releasesInBulk() const
+{
+    return false;
+}
+
+inline void* HeapAllocator::allocate(size_t size, size_t alignment)
+{
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        return ::operator new(size, std::align_val_t(alignment));
+    return ::operator new(size);
+}
+
+inline void HeapAllocator::deallocate(void* ptr, size_t /* size */, size_t alignment)
+{
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        ::operator delete(ptr, std::align_val_t(alignment));
+    else
+        ::operator delete(ptr);
+}
+
+inline Allocator* defaultAllocator()
+{
+    static HeapAllocator heap;
+    return &heap;
+}
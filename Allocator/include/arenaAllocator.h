@@ -0,0 +1,123 @@
+/*  Bump allocator.
+*   Memory is carved sequentially out of large blocks taken from an upstream allocator. deallocate() is a no-op;
+*   everything is given back at once by release() (or the destructor), in O(number of blocks).
+*   To drop a whole container in O(1), place the container itself in the arena as well and release the arena
+*   without running the container's destructor:
+*
+*       ArenaAllocator arena;
+*       auto* table = new (arena.allocate(sizeof(chainTable<int, int>))) chainTable<int, int>(&arena);
+*       ...
+*       arena.release(); // table and all of its buckets/nodes are gone.
+*
+*   This is only valid when the keys/values don't own memory outside the arena (e.g. no std::string).
+*/
+
+#pragma once
+#include "allocator.h"
+#include <cstddef>
+#include <cstdint>
+
+class ArenaAllocator : public Allocator
+{
+    private:
+        struct Block
+        {
+            Block* next;
+            size_t size; // Including this header.
+        };
+
+        Allocator* upstream;
+        size_t blockSize;
+        Block* blocks;
+        char* current;
+        char* end;
+        size_t used;
+
+        void newBlock(size_t minimum);
+
+    public:
+        ArenaAllocator(size_t blockSize = 64 * 1024, Allocator* upstream = defaultAllocator());
+        ArenaAllocator(const ArenaAllocator& other) = delete;
+        ArenaAllocator& operator=(const ArenaAllocator& other) = delete;
+        ~ArenaAllocator();
+
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) override;
+        void deallocate(void* ptr, size_t size, size_t alignment = alignof(std::max_align_t)) override;
+        bool releasesInBulk() const override;
+
+        // Frees every block at once.
+        void release();
+        // Bytes handed out since the last release().
+        size_t bytesUsed() const;
+};
+
+inline ArenaAllocator::ArenaAllocator(size_t blockSize, Allocator* upstream) :
+    upstream(upstream), blockSize(blockSize), blocks(nullptr),
+    current(nullptr), end(nullptr), used(0) {}
+
+inline ArenaAllocator::~ArenaAllocator()
+{
+    release();
+}
+
+// Big requests get a block of their own size.
+inline void ArenaAllocator::newBlock(size_t minimum)
+{
+    size_t size = sizeof(Block) + minimum;
+    if (size < blockSize)
+        size = blockSize;
+
+    Block* block = static_cast<Block*>(upstream->allocate(size));
+    block->next = blocks;
+    block->size = size;
+    blocks = block;
+
+    current = reinterpret_cast<char*>(block + 1);
+    end = reinterpret_cast<char*>(block) + size;
+}
+
+inline void* ArenaAllocator::allocate(size_t size, size_t alignment)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(current);
+    uintptr_t aligned = (address + alignment - 1) & ~(uintptr_t) (alignment - 1);
+
+    if ((current == nullptr) || (aligned + size > reinterpret_cast<uintptr_t>(end)))
+    {
+        newBlock(size + alignment);
+        address = reinterpret_cast<uintptr_t>(current);
+        aligned = (address + alignment - 1) & ~(uintptr_t) (alignment - 1);
+    }
+
+    current = reinterpret_cast<char*>(aligned + size);
+    used += size;
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void ArenaAllocator::deallocate(void* /* ptr */, size_t /* size */, size_t /* alignment */)
+{
+    // Nothing to do; see release().
+}
+
+inline bool ArenaAllocator::releasesInBulk() const
+{
+    return true;
+}
+
+inline void ArenaAllocator::release()
+{
+    while (blocks != nullptr)
+    {
+        Block* next = blocks->next;
+        upstream->deallocate(blocks, blocks->size);
+        blocks = next;
+    }
+
+    current = nullptr;
+    end = nullptr;
+    used = 0;
+}
+
+inline size_t ArenaAllocator::bytesUsed() const
+{
+    return used;
+}
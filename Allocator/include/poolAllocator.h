@@ -0,0 +1,197 @@
+/*  Fixed-size pool allocator.
+*   Every block has the same size. Blocks are carved out of chunks taken from an upstream allocator, and freed
+*   blocks go onto an intrusive free list to be handed out again first, so allocation and deallocation are O(1).
+*   Chunks can grow geometrically (each one twice the size of the last, up to maxBlocksPerChunk) so a pool that
+*   ends up large still only takes a handful of big contiguous slabs.
+*   Requests that don't fit a block (too big or over-aligned) are passed straight through to the upstream allocator,
+*   which makes it safe to give a pool sized for list nodes to a whole container.
+*/
+
+#pragma once
+#include "allocator.h"
+#include <cstddef>
+
+class PoolAllocator : public Allocator
+{
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct Chunk
+        {
+            Chunk* next;
+            size_t size; // Including the header.
+        };
+
+        Allocator* upstream;
+        size_t blockSize;
+        size_t blocksPerChunk; // For the next chunk.
+        size_t maxBlocksPerChunk;
+        size_t blocksInUse;
+        FreeBlock* freeList;
+        Chunk* chunks;
+        // Uncarved part of the newest chunk.
+        char* current;
+        char* end;
+
+        static size_t chunkHeader();
+        bool fits(size_t size, size_t alignment) const;
+        void newChunk(size_t blocks);
+
+    public:
+        // maxBlocksPerChunk defaults to blocksPerChunk (every chunk the same size).
+        PoolAllocator(size_t blockSize, size_t blocksPerChunk = 256,
+            Allocator* upstream = defaultAllocator(), size_t maxBlocksPerChunk = 0);
+        PoolAllocator(const PoolAllocator& other) = delete;
+        PoolAllocator& operator=(const PoolAllocator& other) = delete;
+        ~PoolAllocator();
+
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) override;
+        void deallocate(void* ptr, size_t size, size_t alignment = alignof(std::max_align_t)) override;
+
+        // Carves a chunk big enough for n more blocks up front,
+        // unless the free list and current chunk already cover them.
+        void reserve(size_t n);
+        // Frees every chunk at once.
+        // Any block still in use becomes invalid.
+        void release();
+        size_t block() const;
+        size_t inUse() const;
+        size_t chunkCount() const;
+};
+
+inline PoolAllocator::PoolAllocator(size_t blockSize, size_t blocksPerChunk, Allocator* upstream,
+    size_t maxBlocksPerChunk) :
+    upstream(upstream), blocksPerChunk(blocksPerChunk == 0 ? 1 : blocksPerChunk),
+    maxBlocksPerChunk(maxBlocksPerChunk), blocksInUse(0), freeList(nullptr),
+    chunks(nullptr), current(nullptr), end(nullptr)
+{
+    if (this->maxBlocksPerChunk < this->blocksPerChunk)
+        this->maxBlocksPerChunk = this->blocksPerChunk;
+
+    // Every block has to be able to hold a free list link,
+    // and every block has to stay pointer-aligned.
+    if (blockSize < sizeof(FreeBlock))
+        blockSize = sizeof(FreeBlock);
+    this->blockSize = (blockSize + alignof(FreeBlock) - 1) & ~(alignof(FreeBlock) - 1);
+}
+
+inline PoolAllocator::~PoolAllocator()
+{
+    release();
+}
+
+// Keeps the first block of each chunk max-aligned.
+inline size_t PoolAllocator::chunkHeader()
+{
+    const size_t align = alignof(std::max_align_t);
+    return (sizeof(Chunk) + align - 1) & ~(align - 1);
+}
+
+inline bool PoolAllocator::fits(size_t size, size_t alignment) const
+{
+    return ((size <= blockSize) && (alignment <= alignof(std::max_align_t)) &&
+            (blockSize % alignment == 0));
+}
+
+// Whatever was left of the previous chunk is abandoned
+// until release(); chunks are only replaced once used up
+// (or by reserve(), which only wastes the tail once).
+inline void PoolAllocator::newChunk(size_t blocks)
+{
+    size_t size = chunkHeader() + blockSize * blocks;
+    Chunk* chunk = static_cast<Chunk*>(upstream->allocate(size));
+    chunk->next = chunks;
+    chunk->size = size;
+    chunks = chunk;
+
+    current = reinterpret_cast<char*>(chunk) + chunkHeader();
+    end = reinterpret_cast<char*>(chunk) + size;
+
+    if (blocksPerChunk < maxBlocksPerChunk)
+        blocksPerChunk = (blocksPerChunk * 2 < maxBlocksPerChunk ? blocksPerChunk * 2 : maxBlocksPerChunk);
+}
+
+inline void* PoolAllocator::allocate(size_t size, size_t alignment)
+{
+    if (!fits(size, alignment))
+        return upstream->allocate(size, alignment);
+
+    blocksInUse++;
+
+    if (freeList != nullptr)
+    {
+        FreeBlock* block = freeList;
+        freeList = block->next;
+        return block;
+    }
+
+    if (current == end)
+        newChunk(blocksPerChunk);
+
+    void* block = current;
+    current += blockSize;
+    return block;
+}
+
+inline void PoolAllocator::deallocate(void* ptr, size_t size, size_t alignment)
+{
+    if (ptr == nullptr)
+        return;
+
+    if (!fits(size, alignment))
+    {
+        upstream->deallocate(ptr, size, alignment);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = freeList;
+    freeList = block;
+    blocksInUse--;
+}
+
+inline void PoolAllocator::reserve(size_t n)
+{
+    for (FreeBlock* block = freeList; (block != nullptr) && (n > 0); block = block->next)
+        n--;
+
+    size_t left = (end - current) / blockSize;
+    if (n > left)
+        newChunk(n);
+}
+
+inline void PoolAllocator::release()
+{
+    while (chunks != nullptr)
+    {
+        Chunk* next = chunks->next;
+        upstream->deallocate(chunks, chunks->size);
+        chunks = next;
+    }
+
+    blocksInUse = 0;
+    freeList = nullptr;
+    current = nullptr;
+    end = nullptr;
+}
+
+inline size_t PoolAllocator::block() const
+{
+    return blockSize;
+}
+
+inline size_t PoolAllocator::inUse() const
+{
+    return blocksInUse;
+}
+
+inline size_t PoolAllocator::chunkCount() const
+{
+    size_t count = 0;
+    for (Chunk* chunk = chunks; chunk != nullptr; chunk = chunk->next)
+        count++;
+    return count;
+}
@@ -0,0 +1,52 @@
+#include "../include/arenaAllocator.h"
+#include "../include/poolAllocator.h"
+#include "../../Dynamic-Array/include/array.h"
+#include "../../Hash-Table/Separate-Chaining/include/chainTable.h"
+#include "../../Hash-Table/Linear-Probing/include/linearTable.h"
+#include "../../Linked-List/Singly-Linked-List/Regular/include/linkedList.h"
+#include <iostream>
+#include <new>
+
+int main()
+{
+    ArenaAllocator arena;
+
+    Array<int> array(&arena);
+    for (int i = 0; i < 100; i++)
+        array.push(i);
+    std::cout << "Array size: " << array.count() << '\n';
+    std::cout << "Arena bytes used: " << arena.bytesUsed() << '\n';
+
+    linearTable<int, int> linear(&arena);
+    for (int i = 0; i < 100; i++)
+        linear.add(i, i * 2);
+    std::cout << "Linear table 50: " << *linear.get(50) << '\n';
+
+    // A table placed in the arena itself can be
+    // dropped by releasing the arena.
+    using Table = chainTable<int, int>;
+    Table* table = new (arena.allocate(sizeof(Table), alignof(Table))) Table(&arena);
+    for (int i = 0; i < 1000; i++)
+        table->add(i, i + 1);
+    std::cout << "Arena table size: " << table->entrySize() << '\n';
+    std::cout << "Arena table 500: " << *table->get(500) << '\n';
+    arena.release();
+    std::cout << "Arena bytes used after release: " << arena.bytesUsed() << '\n';
+
+    PoolAllocator pool(sizeof(ListNode<int>));
+    LinkedList<int> list(&pool);
+    for (int i = 0; i < 10; i++)
+        list.append(i + 1);
+    list.remove(5);
+    list.prepend(0); // Reuses the freed node.
+    for (const auto& element : list)
+        std::cout << element << '\n';
+
+    chainTable<int, int> pooled(&pool);
+    for (int i = 0; i < 100; i++)
+        pooled[i] = i;
+    pooled.remove(10);
+    std::cout << "Pool table size: " << pooled.entrySize() << '\n';
+
+    return 0;
+}
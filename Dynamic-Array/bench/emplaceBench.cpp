@@ -0,0 +1,118 @@
+// Counts constructor calls and times pushes for a non-trivial type.
+// EagerArray mimics the old Array strategy (new T[capacity] on every
+// growth, then copy-assignment into the default-constructed slots) so
+// both can be compared in the same run.
+
+#include "../include/array.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+struct Counters
+{
+    long long defaults = 0;
+    long long copies = 0;
+    long long moves = 0;
+    long long destroys = 0;
+
+    void reset() { *this = Counters(); }
+    long long constructed() const { return defaults + copies + moves; }
+};
+
+static Counters counters;
+
+struct Tracked
+{
+    std::string text;
+
+    Tracked() { counters.defaults++; }
+    Tracked(const std::string& text) : text(text) { counters.copies++; }
+    Tracked(const Tracked& other) : text(other.text) { counters.copies++; }
+    Tracked(Tracked&& other) noexcept : text(std::move(other.text)) { counters.moves++; }
+    Tracked& operator=(const Tracked& other) { text = other.text; counters.copies++; return *this; }
+    Tracked& operator=(Tracked&& other) noexcept { text = std::move(other.text); counters.moves++; return *this; }
+    ~Tracked() { counters.destroys++; }
+    bool operator==(const Tracked& other) const { return text == other.text; }
+    bool operator!=(const Tracked& other) const { return text != other.text; }
+};
+
+template<typename T>
+class EagerArray
+{
+    private:
+        T* entries = nullptr;
+        size_t count = 0;
+        size_t capacity = 0;
+
+    public:
+        ~EagerArray() { delete[] entries; }
+
+        void push(T element)
+        {
+            if (capacity <= count)
+            {
+                capacity = (capacity == 0 ? 8 : capacity * 2);
+                T* newEntries = new T[capacity];
+                for (size_t i = 0; i < count; i++)
+                    newEntries[i] = std::move(entries[i]);
+                delete[] entries;
+                entries = newEntries;
+            }
+            entries[count++] = element;
+        }
+};
+
+static const std::string payload = "a key long enough to defeat the small string buffer";
+
+template<typename Func>
+static void run(const char* name, Func func)
+{
+    using namespace std::chrono;
+
+    counters.reset();
+    auto start = high_resolution_clock::now();
+    func();
+    auto finish = high_resolution_clock::now();
+    auto time = duration_cast<microseconds>(finish - start);
+
+    std::cout << name << ": " << counters.constructed() << " constructions ("
+        << counters.defaults << " default), " << counters.destroys
+        << " destructions, " << (long double) time.count() / 1000 << " ms\n";
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 1000000);
+    std::cout << "Pushing " << n << " elements.\n";
+
+    run("EagerArray push", [n]() {
+        EagerArray<Tracked> array;
+        for (int i = 0; i < n; i++)
+            array.push(Tracked(payload));
+    });
+
+    run("Array push", [n]() {
+        Array<Tracked> array;
+        for (int i = 0; i < n; i++)
+            array.push(Tracked(payload));
+    });
+
+    run("Array emplace", [n]() {
+        Array<Tracked> array;
+        for (int i = 0; i < n; i++)
+            array.emplace(payload);
+    });
+
+    run("Array reserve + emplace", [n]() {
+        Array<Tracked> array;
+        array.reserve(n);
+        for (int i = 0; i < n; i++)
+            array.emplace(payload);
+    });
+
+    run("Array(n) construction", [n]() {
+        Array<Tracked> array(n);
+    });
+
+    return 0;
+}
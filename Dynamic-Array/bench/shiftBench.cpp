@@ -0,0 +1,53 @@
+// Times insert()/erase() in the middle of a large Array<int>
+// and growth of an Array of non-trivial elements.
+
+#include "../include/array.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+template<typename Func>
+static void run(const char* name, Func func)
+{
+    using namespace std::chrono;
+
+    auto start = high_resolution_clock::now();
+    func();
+    auto finish = high_resolution_clock::now();
+    auto time = duration_cast<microseconds>(finish - start);
+    std::cout << name << ": " << (long double) time.count() / 1000 << " ms\n";
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 1000000);
+    const int ops = 1000;
+
+    Array<int> numbers;
+    for (int i = 0; i < n; i++)
+        numbers.push(i);
+
+    run("1000 middle inserts (Array<int>)", [&]() {
+        for (int i = 0; i < ops; i++)
+            numbers.insert(-i, (int) numbers.count() / 2);
+    });
+
+    run("1000 middle erases (Array<int>)", [&]() {
+        for (int i = 0; i < ops; i++)
+            numbers.erase((int) numbers.count() / 2);
+    });
+
+    run("1M pushes (Array<std::string>)", [&]() {
+        Array<std::string> strings;
+        for (int i = 0; i < n; i++)
+            strings.emplace("a string long enough to live on the heap");
+    });
+
+    run("Copying 1M ints", [&]() {
+        Array<int> copy = numbers;
+        if (copy.count() != numbers.count())
+            std::cout << "Copy failed.\n";
+    });
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Heap allocations and latency for many tiny collections,
+// Array<int> vs SmallArray<int, 8>.
+
+#include "../include/array.h"
+#include "../include/smallArray.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+static long long allocations = 0;
+
+void* operator new(size_t size)
+{
+    allocations++;
+    if (void* ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+template<typename Container>
+static void run(const char* name, int containers, int elements)
+{
+    using namespace std::chrono;
+
+    long long sum = 0;
+    allocations = 0;
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < containers; i++)
+    {
+        Container array;
+        for (int j = 0; j < elements; j++)
+            array.push(i + j);
+        for (const auto& element : array)
+            sum += element;
+    }
+    auto finish = high_resolution_clock::now();
+    auto time = duration_cast<microseconds>(finish - start);
+
+    std::cout << name << " x" << elements << ": " << allocations << " allocations, "
+        << (long double) time.count() / containers * 1000 << " ns per container"
+        << " (checksum " << sum << ")\n";
+}
+
+int main(int argc, char** argv)
+{
+    const int containers = (argc > 1 ? std::stoi(argv[1]) : 1000000);
+    const int sizes[] = {1, 4, 8, 16};
+
+    for (int elements : sizes)
+    {
+        run<Array<int>>("Array<int>", containers, elements);
+        run<SmallArray<int, 8>>("SmallArray<int, 8>", containers, elements);
+    }
+
+    return 0;
+}
@@ -1,6 +1,12 @@
 #pragma once
+#include "../../Allocator/include/allocator.h"
+#include "relocatable.h"
 #include <cstddef>
+#include <cstring>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #define TEMP template<typename T>
 
@@ -8,16 +14,25 @@ TEMP
 class Array
 {
     private:
+        // Raw storage: only the slots in [0, _count)
+        // hold constructed objects.
         T* entries;
         size_t _count;
         size_t _capacity;
+        Allocator* alloc;
 
+        T* allocate(size_t size);
+        void deallocate(T* ptr, size_t size);
+        static void destroy(T* first, T* last);
+        static void copyRange(const T* first, const T* last, T* dest);
+        void reallocate(size_t capacity);
         void shift(int shift, int start = 0);
 
     public:
         // Constructing Array objects.
         Array();
-        Array(int size);
+        explicit Array(Allocator* alloc);
+        Array(int size, Allocator* alloc = defaultAllocator());
         Array(const Array<T>& other);
         Array(Array<T>&& other);
         Array& operator=(const Array<T>& other);
@@ -30,13 +45,17 @@ class Array
 
         // Utility.
         void grow();
-        // This does not reallocate to a larger array.
-        // It simply increases the capacity field as *if*
-        // we were actually growing the array.
-        // Use with care.
-        inline void increaseCapacity();
+        // Grows the capacity to at least size
+        // without constructing anything.
+        void reserve(size_t size);
 
         void push(T element);
+        // Construct an element in place at the end.
+        template<typename... Args>
+        T& emplace(Args&&... args);
+        // Construct an element in place at index (index <= count).
+        template<typename... Args>
+        T& emplaceAt(int index, Args&&... args);
         int position(T element);
         void insert(T element, int index);
         T erase(int index);
@@ -45,10 +64,17 @@ class Array
         void popn(int n);
         inline size_t count() const;
         inline size_t capacity() const;
+        inline Allocator* allocator() const;
         inline T* front();
         inline T* back();
+        inline const T* front() const;
+        inline const T* back() const;
+        // Slots past count are uninitialized unless the
+        // array was filled up to capacity with fillArray().
         inline T& slot(int index); // index < capacity.
-        void slotInsert(T element, int index); // index < capacity.
+        void slotInsert(T element, int index); // index <= count.
+        // Filling up to capacity also constructs the unused
+        // slots, so count becomes equal to capacity.
         void fillArray(T element, bool capacity = false);
 
         class iterator
@@ -57,7 +83,7 @@ class Array
                 T* ptr;
             
             public:
-                iterator(T* ptr);
+                iterator(T* ptr = nullptr);
                 iterator(const iterator& other);
                 iterator& operator=(const iterator& other);
 
@@ -67,8 +93,8 @@ class Array
                 iterator operator++(int);
                 iterator& operator--();
                 iterator operator--(int);
-                bool operator==(const iterator& other);
-                bool operator!=(const iterator& other);
+                bool operator==(const iterator& other) const;
+                bool operator!=(const iterator& other) const;
         };
 
         class const_iterator
@@ -77,7 +103,7 @@ class Array
                 const T* ptr;
             
             public:
-                const_iterator(const T* ptr);
+                const_iterator(const T* ptr = nullptr);
                 const_iterator(const const_iterator& other);
                 const_iterator& operator=(const const_iterator& other);
 
@@ -102,26 +128,30 @@ class Array
 TEMP
 Array<T>::Array() :
     entries(nullptr), _count(0),
-    _capacity(0) {}
+    _capacity(0), alloc(defaultAllocator()) {}
 
 TEMP
-Array<T>::Array(int size)
+Array<T>::Array(Allocator* alloc) :
+    entries(nullptr), _count(0),
+    _capacity(0), alloc(alloc) {}
+
+TEMP
+Array<T>::Array(int size, Allocator* alloc) :
+    alloc(alloc)
 {
     if (size < 0)
         throw std::out_of_range("Negative size cannot be used.");
-    entries = new T[size];
+    entries = allocate(static_cast<size_t>(size));
     _count = 0; // No elements used at time of construction.
     _capacity = static_cast<size_t>(size);
 }
 
 TEMP
-Array<T>::Array(const Array<T>& other)
+Array<T>::Array(const Array<T>& other) :
+    alloc(other.alloc)
 {
-    this->entries = new T[other._capacity];
-
-    for (size_t i = 0; i < other._capacity; i++)
-        this->entries[i] = other.entries[i];
-
+    this->entries = allocate(other._capacity);
+    copyRange(other.entries, other.entries + other._count, this->entries);
     this->_count = other._count;
     this->_capacity = other._capacity;
 }
@@ -132,6 +162,7 @@ Array<T>::Array(Array<T>&& other)
     this->entries = other.entries;
     this->_count = other._count;
     this->_capacity = other._capacity;
+    this->alloc = other.alloc;
 
     other.entries = nullptr;
     other._count = 0;
@@ -143,12 +174,11 @@ Array<T>& Array<T>::operator=(const Array<T>& other)
 {
     if (this != &other)
     {
-        delete[] this->entries;
-        this->entries = new T[other._capacity];
-
-        for (size_t i = 0; i < other._capacity; i++)
-            this->entries[i] = other.entries[i];
-
+        // Keeps our own allocator.
+        destroy(this->entries, this->entries + this->_count);
+        deallocate(this->entries, this->_capacity);
+        this->entries = allocate(other._capacity);
+        copyRange(other.entries, other.entries + other._count, this->entries);
         this->_count = other._count;
         this->_capacity = other._capacity;
     }
@@ -161,11 +191,14 @@ Array<T>& Array<T>::operator=(Array<T>&& other)
 {
     if (this != &other)
     {
-        delete[] this->entries;
+        destroy(this->entries, this->entries + this->_count);
+        deallocate(this->entries, this->_capacity);
 
+        // The buffer still belongs to other's allocator.
         this->entries = other.entries;
         this->_count = other._count;
         this->_capacity = other._capacity;
+        this->alloc = other.alloc;
 
         other.entries = nullptr;
         other._count = 0;
@@ -178,9 +211,75 @@ Array<T>& Array<T>::operator=(Array<T>&& other)
 TEMP
 Array<T>::~Array()
 {
+    destroy(entries, entries + _count);
+    deallocate(entries, _capacity);
     _count = 0;
     _capacity = 0;
-    delete[] entries;
+}
+
+TEMP
+T* Array<T>::allocate(size_t size)
+{
+    if (size == 0)
+        return nullptr;
+    return static_cast<T*>(alloc->allocate(size * sizeof(T), alignof(T)));
+}
+
+TEMP
+void Array<T>::deallocate(T* ptr, size_t size)
+{
+    if (ptr != nullptr)
+        alloc->deallocate(ptr, size * sizeof(T), alignof(T));
+}
+
+TEMP
+void Array<T>::destroy(T* first, T* last)
+{
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        for (; first != last; first++)
+            first->~T();
+    }
+}
+
+// Copy-constructs [first, last) into raw memory at dest.
+TEMP
+void Array<T>::copyRange(const T* first, const T* last, T* dest)
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (first != last)
+            std::memcpy((void*) dest, (const void*) first, (last - first) * sizeof(T));
+    }
+    else
+    {
+        for (; first != last; first++, dest++)
+            new (dest) T(*first);
+    }
+}
+
+// Moves the constructed elements into a fresh
+// buffer of the given capacity (>= count).
+TEMP
+void Array<T>::reallocate(size_t capacity)
+{
+    T* newEntries = allocate(capacity);
+    if constexpr (isRelocatable_v<T>)
+    {
+        // The old copies are simply forgotten.
+        if (_count != 0)
+            std::memcpy((void*) newEntries, (void*) entries, _count * sizeof(T));
+    }
+    else
+    {
+        for (size_t i = 0; i < _count; i++)
+            new (newEntries + i) T(std::move(entries[i]));
+        destroy(entries, entries + _count);
+    }
+    deallocate(entries, _capacity);
+    this->entries = newEntries;
+    _capacity = capacity;
+    // this->count does not change.
 }
 
 TEMP
@@ -209,28 +308,56 @@ bool Array<T>::operator==(const Array<T>& other)
 TEMP
 void Array<T>::grow()
 {
-    _capacity = (_capacity == 0 ? 8 : _capacity * 2);
-    T* newEntries = new T[_capacity];
-    for (int i = 0; i < (int) _count; i++)
-        newEntries[i] = std::move(entries[i]);
-    delete[] entries;
-    this->entries = newEntries;
-    // this->count does not change.
-    // newEntries goes out of scope here.
+    reallocate(_capacity == 0 ? 8 : _capacity * 2);
 }
 
 TEMP
-inline void Array<T>::increaseCapacity()
+void Array<T>::reserve(size_t size)
 {
-    _capacity = (_capacity == 0 ? 8 : _capacity * 2);
+    if (size > _capacity)
+        reallocate(size);
 }
 
 TEMP
 void Array<T>::push(T element)
+{
+    emplace(std::move(element));
+}
+
+TEMP
+template<typename... Args>
+T& Array<T>::emplace(Args&&... args)
 {
     if (_capacity <= _count)
+    {
+        // The arguments may refer to one of our own
+        // elements, so build the object before moving
+        // everything to the new buffer.
+        T element(std::forward<Args>(args)...);
         grow();
-    entries[(int) _count++] = element;
+        return *(new (entries + _count++) T(std::move(element)));
+    }
+
+    return *(new (entries + _count++) T(std::forward<Args>(args)...));
+}
+
+TEMP
+template<typename... Args>
+T& Array<T>::emplaceAt(int index, Args&&... args)
+{
+    if ((index < 0) || ((size_t) index > _count))
+        throw std::out_of_range("Invalid index.");
+
+    if ((size_t) index == _count)
+        return emplace(std::forward<Args>(args)...);
+
+    // Same aliasing concern as emplace(); shifting
+    // moves the elements the arguments may refer to.
+    T element(std::forward<Args>(args)...);
+    shift(1, index);
+    new (entries + index) T(std::move(element));
+    _count++;
+    return entries[index];
 }
 
 TEMP
@@ -245,50 +372,60 @@ int Array<T>::position(T element)
     return -1;
 }
 
-// When using this function, any unshifted
-// buffer area in the array must be replaced/
-// initialized immediately to maintain
-// the contiguous storage of elements in the array.
+// Moves the elements in [start, count) by shift slots, in place.
+// A positive shift leaves [start, start + shift) unconstructed,
+// and the caller must construct those slots immediately to
+// maintain the contiguous storage of elements in the array.
+// A negative shift destroys the elements it writes over.
+// Either way, the caller is responsible for updating count.
 TEMP
 void Array<T>::shift(int shift, int start)
 {
     if ((shift == 0) || (_count == 0)) // Nothing to do.
         return;
 
-    // We allow the shift to be negative
-    // for element removal.
-    // Just need to be careful when using
-    // that internally.
-
     // Can't be too negative, though.
-    if (shift < (-1 * (int) _count))
+    if ((shift < 0) && (start + shift < 0))
         return; // Throw error?
 
-    if ((start < 0) || (start >= _count))
+    if ((start < 0) || (start > _count))
         return; // Throw error?
 
     // Shift might be large, so we
     // repeatedly grow until capacity is enough.
-    while (_capacity < _count + shift)
+    while ((shift > 0) && (_capacity < _count + shift))
         grow();
-    
-    // To avoid data corruption, we make a
-    // new internal array.
-    // Note: we don't use an Array<T> local
-    // variable since its destructor (called when
-    // it goes out of scope by the end of this function)
-    // will deallocate the memory we just "filled up".
-
-    T* newEntries = new T[_capacity];
-    for (int i = 0; i < start; i++)
-        newEntries[i] = this->entries[i];
-    
-    for (int i = start; i < _count; i++)
-        newEntries[i + shift] = this->entries[i];
-    delete[] this->entries;
-    this->entries = newEntries;
-    // Only increment count when we fill the
-    // empty spots.
+
+    int count = (int) _count;
+
+    if constexpr (isRelocatable_v<T>)
+    {
+        if (shift < 0)
+            destroy(entries + start + shift, entries + start);
+        // Whatever is left behind in the gap is just stale bytes.
+        std::memmove((void*) (entries + start + shift), (void*) (entries + start),
+            (count - start) * sizeof(T));
+    }
+    else if (shift > 0)
+    {
+        // Walk backwards so nothing is overwritten before it moves.
+        // Slots past count are raw, so those are constructed.
+        for (int i = count - 1; i >= start; i--)
+        {
+            if (i + shift >= count)
+                new (entries + i + shift) T(std::move(entries[i]));
+            else
+                entries[i + shift] = std::move(entries[i]);
+        }
+        int gapEnd = (start + shift < count ? start + shift : count);
+        destroy(entries + start, entries + gapEnd);
+    }
+    else
+    {
+        for (int i = start; i < count; i++)
+            entries[i + shift] = std::move(entries[i]);
+        destroy(entries + count + shift, entries + count);
+    }
 }
 
 TEMP
@@ -296,13 +433,8 @@ void Array<T>::insert(T element, int index)
 {
     if ((index < 0) || (index >= _count))
         throw std::out_of_range("Invalid index.");
-    
-    if (_capacity <= _count)
-        grow();
 
-    shift(1, index);
-    entries[index] = element;
-    _count++;
+    emplaceAt(index, std::move(element));
 }
 
 TEMP
@@ -311,7 +443,7 @@ T Array<T>::erase(int index)
     if ((index < 0) || (index >= _count))
         throw std::out_of_range("Invalid index.");
 
-    T element = entries[index];
+    T element = std::move(entries[index]);
     // Shift begins at the index we pass to shift().
     // We want to move every element *after*
     // the parameter index (here) back, so we add 1.
@@ -334,7 +466,9 @@ TEMP
 inline T Array<T>::pop()
 {
     _count--;
-    return entries[(int) _count];
+    T element = std::move(entries[(int) _count]);
+    destroy(entries + _count, entries + _count + 1);
+    return element;
 }
 
 TEMP
@@ -359,6 +493,12 @@ inline size_t Array<T>::capacity() const
     return _capacity;
 }
 
+TEMP
+inline Allocator* Array<T>::allocator() const
+{
+    return alloc;
+}
+
 TEMP
 inline T* Array<T>::front()
 {
@@ -371,6 +511,18 @@ inline T* Array<T>::back()
     return entries + _count;
 }
 
+TEMP
+inline const T* Array<T>::front() const
+{
+    return entries;
+}
+
+TEMP
+inline const T* Array<T>::back() const
+{
+    return entries + _count;
+}
+
 TEMP
 inline T& Array<T>::slot(int index)
 {
@@ -384,13 +536,12 @@ void Array<T>::slotInsert(T element, int index)
 {
     if ((index < 0) || ((size_t) index >= _capacity))
         throw std::out_of_range("Invalid index");
-        
-    if (_capacity <= _count)
-        grow();
+    // Anything past count would leave unconstructed
+    // slots in the middle of the array.
+    if ((size_t) index > _count)
+        throw std::out_of_range("Slot is past the last element.");
 
-    shift(1, index);
-    entries[index] = element;
-    _count++;
+    emplaceAt(index, std::move(element));
 }
 
 TEMP
@@ -401,7 +552,8 @@ void Array<T>::fillArray(T object, bool capacity)
     if (capacity)
     {
         for (size_t i = _count; i < _capacity; i++)
-            entries[i] = object;
+            new (entries + i) T(object);
+        _count = _capacity;
     }
 }
 
@@ -467,13 +619,13 @@ typename arrIter arrIter::operator--(int n)
 }
 
 TEMP
-bool arrIter::operator==(const arrIter& other)
+bool arrIter::operator==(const arrIter& other) const
 {
     return (this->ptr == other.ptr);
 }
 
 TEMP
-bool arrIter::operator!=(const arrIter& other)
+bool arrIter::operator!=(const arrIter& other) const
 {
     return (this->ptr != other.ptr);
 }
@@ -566,23 +718,23 @@ bool constArrIter::operator!=(const const_iterator& other) const
 TEMP
 typename constArrIter Array<T>::begin() const noexcept
 {
-    return const_iterator(front());
+    return const_iterator(entries);
 }
 
 TEMP
 typename constArrIter Array<T>::end() const noexcept
 {
-    return const_iterator(back());
+    return const_iterator(entries + _count);
 }
 
 TEMP
 typename constArrIter Array<T>::cbegin() const noexcept
 {
-    return const_iterator(front());
+    return const_iterator(entries);
 }
 
 TEMP
 typename constArrIter Array<T>::cend() const noexcept
 {
-    return const_iterator(back());
+    return const_iterator(entries + _count);
 }
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+#include <type_traits>
+
+// A type is trivially relocatable if moving it to a new address
+// and forgetting the old copy is the same as a bitwise copy.
+// Array uses memcpy/memmove for these instead of calling move
+// constructors and destructors.
+// Every trivially copyable type qualifies. Other types (that
+// don't point into themselves) can opt in by specializing this.
+template<typename T>
+struct isRelocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+inline constexpr bool isRelocatable_v = isRelocatable<T>::value;
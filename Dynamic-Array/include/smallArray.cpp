@@ -0,0 +1 @@
+#include "smallArray.h"
\ No newline at end of file
@@ -0,0 +1,533 @@
+/*  A dynamic array with a small inline buffer.
+*   The first N elements live inside the object itself, so small collections never touch the heap. Once the array
+*   grows past N elements, everything moves to a heap buffer and it behaves exactly like Array<T>.
+*   The interface (and iterators) match Array<T>, so the two can be swapped.
+*/
+
+#pragma once
+#include "array.h"
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#define SMALLTEMP template<typename T, size_t N>
+
+template<typename T, size_t N = 8>
+class SmallArray
+{
+    static_assert(N > 0, "SmallArray needs room for at least one inline element.");
+
+    private:
+        // Points at buffer while the elements fit inline.
+        // Only the slots in [0, _count) hold constructed objects.
+        T* entries;
+        size_t _count;
+        size_t _capacity;
+        // Only used once we spill to the heap.
+        Allocator* alloc;
+        alignas(T) unsigned char buffer[N * sizeof(T)];
+
+        T* inlineBuffer();
+        bool isInline() const;
+        void release();
+        void moveFrom(SmallArray<T, N>& other);
+        void reallocate(size_t capacity);
+        void shift(int shift, int start = 0);
+
+    public:
+        using iterator = typename Array<T>::iterator;
+        using const_iterator = typename Array<T>::const_iterator;
+
+        // Constructing SmallArray objects.
+        SmallArray();
+        explicit SmallArray(Allocator* alloc);
+        SmallArray(int size, Allocator* alloc = defaultAllocator());
+        SmallArray(const SmallArray<T, N>& other);
+        SmallArray(SmallArray<T, N>&& other);
+        SmallArray& operator=(const SmallArray<T, N>& other);
+        SmallArray& operator=(SmallArray<T, N>&& other);
+        ~SmallArray();
+
+        // Basic operators.
+        inline T& operator[](int index); // index < count.
+        bool operator==(const SmallArray<T, N>& other);
+
+        // Utility.
+        void grow();
+        void reserve(size_t size);
+
+        void push(T element);
+        template<typename... Args>
+        T& emplace(Args&&... args);
+        template<typename... Args>
+        T& emplaceAt(int index, Args&&... args);
+        int position(T element);
+        void insert(T element, int index);
+        T erase(int index);
+        void remove(T element);
+        inline T pop();
+        void popn(int n);
+        inline size_t count() const;
+        inline size_t capacity() const;
+        // True while no heap buffer is in use.
+        inline bool small() const;
+        inline Allocator* allocator() const;
+        inline T* front();
+        inline T* back();
+        inline T& slot(int index); // index < capacity.
+        void slotInsert(T element, int index); // index <= count.
+        void fillArray(T element, bool capacity = false);
+
+        iterator begin() noexcept;
+        iterator end() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+};
+
+SMALLTEMP
+SmallArray<T, N>::SmallArray() :
+    SmallArray(defaultAllocator()) {}
+
+SMALLTEMP
+SmallArray<T, N>::SmallArray(Allocator* alloc) :
+    entries(inlineBuffer()), _count(0),
+    _capacity(N), alloc(alloc) {}
+
+SMALLTEMP
+SmallArray<T, N>::SmallArray(int size, Allocator* alloc) :
+    SmallArray(alloc)
+{
+    if (size < 0)
+        throw std::out_of_range("Negative size cannot be used.");
+    reserve(static_cast<size_t>(size));
+}
+
+SMALLTEMP
+SmallArray<T, N>::SmallArray(const SmallArray<T, N>& other) :
+    SmallArray(other.alloc)
+{
+    reserve(other._count);
+    for (size_t i = 0; i < other._count; i++)
+        new (entries + i) T(other.entries[i]);
+    _count = other._count;
+}
+
+SMALLTEMP
+SmallArray<T, N>::SmallArray(SmallArray<T, N>&& other) :
+    SmallArray(other.alloc)
+{
+    moveFrom(other);
+}
+
+SMALLTEMP
+SmallArray<T, N>& SmallArray<T, N>::operator=(const SmallArray<T, N>& other)
+{
+    if (this != &other)
+    {
+        release();
+        reserve(other._count);
+        for (size_t i = 0; i < other._count; i++)
+            new (entries + i) T(other.entries[i]);
+        _count = other._count;
+    }
+
+    return *this;
+}
+
+SMALLTEMP
+SmallArray<T, N>& SmallArray<T, N>::operator=(SmallArray<T, N>&& other)
+{
+    if (this != &other)
+    {
+        release();
+        moveFrom(other);
+    }
+
+    return *this;
+}
+
+SMALLTEMP
+SmallArray<T, N>::~SmallArray()
+{
+    release();
+}
+
+SMALLTEMP
+T* SmallArray<T, N>::inlineBuffer()
+{
+    return reinterpret_cast<T*>(buffer);
+}
+
+SMALLTEMP
+bool SmallArray<T, N>::isInline() const
+{
+    return (entries == reinterpret_cast<const T*>(buffer));
+}
+
+// Destroys everything and goes back to the inline buffer.
+SMALLTEMP
+void SmallArray<T, N>::release()
+{
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        for (size_t i = 0; i < _count; i++)
+            entries[i].~T();
+    }
+    if (!isInline())
+        alloc->deallocate(entries, _capacity * sizeof(T), alignof(T));
+
+    entries = inlineBuffer();
+    _count = 0;
+    _capacity = N;
+}
+
+// Expects this array to be empty and inline.
+SMALLTEMP
+void SmallArray<T, N>::moveFrom(SmallArray<T, N>& other)
+{
+    if (!other.isInline())
+    {
+        // Steal the heap buffer (and the allocator it came from).
+        entries = other.entries;
+        _count = other._count;
+        _capacity = other._capacity;
+        alloc = other.alloc;
+    }
+    else
+    {
+        // Inline elements have to actually move.
+        for (size_t i = 0; i < other._count; i++)
+        {
+            new (entries + i) T(std::move(other.entries[i]));
+            other.entries[i].~T();
+        }
+        _count = other._count;
+    }
+
+    other.entries = other.inlineBuffer();
+    other._count = 0;
+    other._capacity = N;
+}
+
+// Moves the elements to a heap buffer of the
+// given capacity (> N, >= count).
+SMALLTEMP
+void SmallArray<T, N>::reallocate(size_t capacity)
+{
+    T* newEntries = static_cast<T*>(alloc->allocate(capacity * sizeof(T), alignof(T)));
+    if constexpr (isRelocatable_v<T>)
+    {
+        if (_count != 0)
+            std::memcpy((void*) newEntries, (void*) entries, _count * sizeof(T));
+    }
+    else
+    {
+        for (size_t i = 0; i < _count; i++)
+        {
+            new (newEntries + i) T(std::move(entries[i]));
+            entries[i].~T();
+        }
+    }
+    if (!isInline())
+        alloc->deallocate(entries, _capacity * sizeof(T), alignof(T));
+
+    entries = newEntries;
+    _capacity = capacity;
+}
+
+// Same contract as Array<T>::shift().
+SMALLTEMP
+void SmallArray<T, N>::shift(int shift, int start)
+{
+    if ((shift == 0) || (_count == 0))
+        return;
+
+    if ((shift < 0) && (start + shift < 0))
+        return;
+
+    if ((start < 0) || (start > _count))
+        return;
+
+    while ((shift > 0) && (_capacity < _count + shift))
+        grow();
+
+    int count = (int) _count;
+
+    if constexpr (isRelocatable_v<T>)
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            for (int i = start + shift; i < start; i++)
+                entries[i].~T();
+        }
+        std::memmove((void*) (entries + start + shift), (void*) (entries + start),
+            (count - start) * sizeof(T));
+    }
+    else if (shift > 0)
+    {
+        for (int i = count - 1; i >= start; i--)
+        {
+            if (i + shift >= count)
+                new (entries + i + shift) T(std::move(entries[i]));
+            else
+                entries[i + shift] = std::move(entries[i]);
+        }
+        int gapEnd = (start + shift < count ? start + shift : count);
+        for (int i = start; i < gapEnd; i++)
+            entries[i].~T();
+    }
+    else
+    {
+        for (int i = start; i < count; i++)
+            entries[i + shift] = std::move(entries[i]);
+        for (int i = count + shift; i < count; i++)
+            entries[i].~T();
+    }
+}
+
+SMALLTEMP
+inline T& SmallArray<T, N>::operator[](int index)
+{
+    if ((index < 0) || ((size_t) index >= _count))
+        throw std::out_of_range("Invalid index.");
+
+    return entries[index];
+}
+
+SMALLTEMP
+bool SmallArray<T, N>::operator==(const SmallArray<T, N>& other)
+{
+    if (this->_count != other._count) return false;
+
+    for (size_t i = 0; i < this->_count; i++)
+    {
+        if (this->entries[i] != other.entries[i])
+            return false;
+    }
+
+    return true;
+}
+
+SMALLTEMP
+void SmallArray<T, N>::grow()
+{
+    reallocate(_capacity * 2);
+}
+
+SMALLTEMP
+void SmallArray<T, N>::reserve(size_t size)
+{
+    if (size > _capacity)
+        reallocate(size);
+}
+
+SMALLTEMP
+void SmallArray<T, N>::push(T element)
+{
+    emplace(std::move(element));
+}
+
+SMALLTEMP
+template<typename... Args>
+T& SmallArray<T, N>::emplace(Args&&... args)
+{
+    if (_capacity <= _count)
+    {
+        // The arguments may refer to one of our own elements.
+        T element(std::forward<Args>(args)...);
+        grow();
+        return *(new (entries + _count++) T(std::move(element)));
+    }
+
+    return *(new (entries + _count++) T(std::forward<Args>(args)...));
+}
+
+SMALLTEMP
+template<typename... Args>
+T& SmallArray<T, N>::emplaceAt(int index, Args&&... args)
+{
+    if ((index < 0) || ((size_t) index > _count))
+        throw std::out_of_range("Invalid index.");
+
+    if ((size_t) index == _count)
+        return emplace(std::forward<Args>(args)...);
+
+    T element(std::forward<Args>(args)...);
+    shift(1, index);
+    new (entries + index) T(std::move(element));
+    _count++;
+    return entries[index];
+}
+
+SMALLTEMP
+int SmallArray<T, N>::position(T element)
+{
+    for (size_t i = 0; i < _count; i++)
+    {
+        if (entries[i] == element)
+            return (int) i;
+    }
+
+    return -1;
+}
+
+SMALLTEMP
+void SmallArray<T, N>::insert(T element, int index)
+{
+    if ((index < 0) || (index >= _count))
+        throw std::out_of_range("Invalid index.");
+
+    emplaceAt(index, std::move(element));
+}
+
+SMALLTEMP
+T SmallArray<T, N>::erase(int index)
+{
+    if ((index < 0) || (index >= _count))
+        throw std::out_of_range("Invalid index.");
+
+    T element = std::move(entries[index]);
+    shift(-1, index + 1);
+    _count--;
+    return element;
+}
+
+SMALLTEMP
+void SmallArray<T, N>::remove(T element)
+{
+    int index = position(element);
+    if (index == -1)
+        return;
+
+    erase(index);
+}
+
+SMALLTEMP
+inline T SmallArray<T, N>::pop()
+{
+    _count--;
+    T element = std::move(entries[_count]);
+    entries[_count].~T();
+    return element;
+}
+
+SMALLTEMP
+void SmallArray<T, N>::popn(int n)
+{
+    while (n > 0)
+    {
+        pop();
+        n--;
+    }
+}
+
+SMALLTEMP
+inline size_t SmallArray<T, N>::count() const
+{
+    return _count;
+}
+
+SMALLTEMP
+inline size_t SmallArray<T, N>::capacity() const
+{
+    return _capacity;
+}
+
+SMALLTEMP
+inline bool SmallArray<T, N>::small() const
+{
+    return isInline();
+}
+
+SMALLTEMP
+inline Allocator* SmallArray<T, N>::allocator() const
+{
+    return alloc;
+}
+
+SMALLTEMP
+inline T* SmallArray<T, N>::front()
+{
+    return entries;
+}
+
+SMALLTEMP
+inline T* SmallArray<T, N>::back()
+{
+    return entries + _count;
+}
+
+SMALLTEMP
+inline T& SmallArray<T, N>::slot(int index)
+{
+    if ((index < 0) || ((size_t) index >= _capacity))
+        throw std::out_of_range("Invalid index.");
+    return entries[index];
+}
+
+SMALLTEMP
+void SmallArray<T, N>::slotInsert(T element, int index)
+{
+    if ((index < 0) || ((size_t) index >= _capacity))
+        throw std::out_of_range("Invalid index");
+    if ((size_t) index > _count)
+        throw std::out_of_range("Slot is past the last element.");
+
+    emplaceAt(index, std::move(element));
+}
+
+SMALLTEMP
+void SmallArray<T, N>::fillArray(T object, bool capacity)
+{
+    for (size_t i = 0; i < _count; i++)
+        entries[i] = object;
+    if (capacity)
+    {
+        for (size_t i = _count; i < _capacity; i++)
+            new (entries + i) T(object);
+        _count = _capacity;
+    }
+}
+
+// Iterators are shared with Array<T>.
+
+SMALLTEMP
+typename SmallArray<T, N>::iterator SmallArray<T, N>::begin() noexcept
+{
+    return iterator(entries);
+}
+
+SMALLTEMP
+typename SmallArray<T, N>::iterator SmallArray<T, N>::end() noexcept
+{
+    return iterator(entries + _count);
+}
+
+SMALLTEMP
+typename SmallArray<T, N>::const_iterator SmallArray<T, N>::begin() const noexcept
+{
+    return const_iterator(entries);
+}
+
+SMALLTEMP
+typename SmallArray<T, N>::const_iterator SmallArray<T, N>::end() const noexcept
+{
+    return const_iterator(entries + _count);
+}
+
+SMALLTEMP
+typename SmallArray<T, N>::const_iterator SmallArray<T, N>::cbegin() const noexcept
+{
+    return const_iterator(entries);
+}
+
+SMALLTEMP
+typename SmallArray<T, N>::const_iterator SmallArray<T, N>::cend() const noexcept
+{
+    return const_iterator(entries + _count);
+}
@@ -1,4 +1,5 @@
 #include "../include/array.h"
+#include "../include/smallArray.h"
 #include <iostream>
 
 int main()
@@ -20,8 +21,21 @@ int main()
     Array<int> array2 = array1;
     std::cout << "Array 1 Size: " << array1.count() << '\n';
     std::cout << "Array 1 Capacity: " << array1.capacity() << '\n';
-    setCount(array2, 12);
+    array2.reserve(32);
+    array2.emplace(12);
+    array2.emplaceAt(0, 0);
     std::cout << "Array 2 Size: " << array2.count() << '\n';
     std::cout << "Array 2 Capacity: " << array2.capacity() << '\n';
+    std::cout << "Array 2 Front: " << array2[0] << '\n';
+
+    SmallArray<int, 4> small;
+    for (int i = 0; i < 4; i++)
+        small.push(i + 1);
+    std::cout << "Small array inline: " << (small.small() ? "true" : "false") << '\n';
+    small.insert(-1, 2);
+    std::cout << "Small array inline: " << (small.small() ? "true" : "false") << '\n';
+    std::cout << "Erased: " << small.erase(2) << '\n';
+    for (const auto& i : small)
+        std::cout << i << '\n';
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,13 @@
+/*  Timing helper shared by the bench programs.
+*/
+
+#pragma once
+#include <chrono>
+
+// Milliseconds since start, to the microsecond.
+inline long double elapsed(std::chrono::steady_clock::time_point start)
+{
+    using namespace std::chrono;
+    auto time = duration_cast<microseconds>(steady_clock::now() - start);
+    return (long double) time.count() / 1000;
+}
@@ -0,0 +1,108 @@
+// Lookup throughput of coroutine-interleaved lookups against
+// group size, next to get() in a loop (and getBatch() for the
+// open-addressing tables), on tables far bigger than the
+// last-level cache. Lookups are random, half of them hits.
+// Needs C++20 (the Makefile builds it with -std=gnu++20).
+
+#include "../../Linear-Probing/include/linearTable.h"
+#include "../../Linear-Probing/include/robinTable.h"
+#include "../../Separate-Chaining/include/chainTable.h"
+#include "../../../General/benchTimer.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+static uint32_t next(uint32_t& state) // xorshift
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static long sum(const std::vector<int*>& values)
+{
+    long total = 0;
+    for (int* value : values)
+        total += (value != nullptr ? *value : -1);
+    return total;
+}
+
+template<typename Table>
+static void run(const char* name, Table& table, const std::vector<int>& lookups)
+{
+    const size_t block = 1024; // Keys handed over per call.
+    long double count = lookups.size();
+    std::vector<int*> values(lookups.size());
+    std::cout << name << ":\n";
+
+    auto start = steady_clock::now();
+    for (size_t i = 0; i < lookups.size(); i++)
+        values[i] = table.get(lookups[i]);
+    long double time = elapsed(start);
+    long expected = sum(values);
+    std::cout << "  get:        " << count / time / 1000 << " M/s\n";
+
+    // Only the open-addressing tables have it.
+    if constexpr (requires { table.getBatch(lookups.data(), block, values.data()); })
+    {
+        start = steady_clock::now();
+        for (size_t i = 0; i < lookups.size(); i += block)
+            table.getBatch(&lookups[i], block, &values[i]);
+        time = elapsed(start);
+        std::cout << "  getBatch:   " << count / time / 1000 << " M/s"
+            << (sum(values) == expected ? "" : " (WRONG)") << '\n';
+    }
+
+    for (size_t group : {1, 2, 4, 8, 16, 32, 64})
+    {
+        start = steady_clock::now();
+        for (size_t i = 0; i < lookups.size(); i += block)
+            interleavedGet(table, &lookups[i], block, &values[i], group);
+        time = elapsed(start);
+        std::cout << "  group " << group << (group < 10 ? ":  " : ": ") << "  "
+            << count / time / 1000 << " M/s" << (sum(values) == expected ? "" : " (WRONG)") << '\n';
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 1 << 22);
+    const int count = (argc > 2 ? std::stoi(argv[2]) : 1 << 22);
+
+    // Keys below n are in the tables, the rest aren't.
+    std::vector<int> lookups(count / 1024 * 1024);
+    uint32_t state = 2463534242u;
+    for (size_t i = 0; i < lookups.size(); i++)
+        lookups[i] = static_cast<int>(next(state) % (2u * n));
+    std::cout << n << " entries, " << lookups.size() << " lookups\n";
+
+    {
+        linearTable<int, int> table;
+        for (int i = 0; i < n; i++)
+            table.add(i, i);
+        run("linearTable", table, lookups);
+    }
+    {
+        robinTable<int, int> table;
+        for (int i = 0; i < n; i++)
+            table.add(i, i);
+        run("robinTable", table, lookups);
+    }
+    {
+        // Keys added in a scattered order, so neighboring
+        // chain nodes aren't neighbors in memory.
+        chainTable<int, int> table;
+        for (int i = 0; i < n; i++)
+        {
+            int key = static_cast<int>(((uint32_t) i * 2654435761u) % (uint32_t) n);
+            table.add(key, key);
+        }
+        run("chainTable", table, lookups);
+    }
+    return 0;
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
 #define KVTEMP template<typename Key, typename Value>
@@ -10,6 +11,30 @@ enum EntryState
     EMPTY
 };
 
+// What the open-addressing tables' findOrInsert() hands back: the
+// value stored under the key, and whether the key had to be added.
+template<typename Value>
+struct InsertResult
+{
+    Value& value;
+    bool inserted;
+};
+
+// How many keys the open-addressing tables' batched lookups
+// hash and prefetch before probing for any of them; enough to
+// keep a good number of cache misses in flight at once.
+constexpr size_t lookupBatch = 16;
+
+// Asks for the cache line holding ptr without waiting for it.
+inline void prefetchRead(const void* ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(ptr, 0, 3);
+#else
+    (void) ptr;
+#endif
+}
+
 KVTEMP
 struct Entry
 {
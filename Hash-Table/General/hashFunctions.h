@@ -8,19 +8,31 @@
 using Hash = uint32_t;
 
 template<typename Key>
-Hash hashKey(Key key, size_t size = -1);
+Hash hashKey(const Key& key, size_t size = -1);
 template<typename T>
 Hash hashNumeric(T key);
 Hash hashChar(char key);
 Hash hashString(std::string_view string);
 Hash hashCStr(const char* string, size_t length = -1);
 
+// String keys can be looked up by anything that converts to a
+// std::string_view (like a const char*) without building a Key:
+// both hash the same bytes and compare with ==.
+template<typename Key, typename K>
+constexpr bool isTransparentKey =
+    (std::is_same_v<Key, std::string> || std::is_same_v<Key, std::string_view>) &&
+    !std::is_same_v<K, Key> && std::is_convertible_v<const K&, std::string_view>;
+
+// For the tables' transparent overloads.
+template<typename Key, typename K>
+using TransparentKey = std::enable_if_t<isTransparentKey<Key, K>>;
+
 // Need to have the implementations here since
 // this file is #included in source files
 // with template implementations.
 
 template<typename Key>
-Hash hashKey(Key key, size_t size)
+Hash hashKey(const Key& key, size_t size)
 {
     if constexpr (std::is_arithmetic_v<Key>)
         return hashNumeric(key);
@@ -0,0 +1,232 @@
+/*  Coroutine-interleaved lookups (C++20 only; the rest of the tables don't need it, so this header is empty
+*   under C++17).
+*   A table's lookupTask(key, &out) is a coroutine that prefetches whatever it is about to read next (a home slot,
+*   a bucket, the next chain node) and suspends instead of waiting for it. interleave() keeps a group of those
+*   lookups in flight and resumes them in turn, so by the time a lookup comes around again its line has usually
+*   arrived, and the latency of one lookup's misses is hidden behind the work of the others. Unlike getBatch(),
+*   this also covers dependent loads, such as following a chain in chainTable, where the next address is only
+*   known once the current node has been read.
+*   A lookup can co_await another LookupTask (chainTable awaits its bucket's); the scheduler always resumes the
+*   innermost one. Frames come from a per-thread pool, since every lookup gets a fresh one.
+*/
+
+#pragma once
+
+#ifdef __cpp_impl_coroutine
+#include "../../Allocator/include/poolAllocator.h"
+#include "entryStruct.h"
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+class LookupTask
+{
+    public:
+        struct promise_type
+        {
+            // Whatever co_awaited this task, if anything.
+            std::coroutine_handle<> continuation;
+            // The scheduler's handle for the whole lookup:
+            // the coroutine to resume next.
+            std::coroutine_handle<>* current = nullptr;
+
+            struct FinalAwaiter
+            {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+                void await_resume() noexcept {}
+            };
+
+            LookupTask get_return_object();
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            FinalAwaiter final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+
+            static void* operator new(size_t size);
+            static void operator delete(void* ptr, size_t size);
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+        explicit LookupTask(std::coroutine_handle<promise_type> handle);
+        static PoolAllocator& framePool();
+
+    public:
+        LookupTask();
+        LookupTask(const LookupTask& other) = delete;
+        LookupTask(LookupTask&& other);
+        LookupTask& operator=(const LookupTask& other) = delete;
+        LookupTask& operator=(LookupTask&& other);
+        ~LookupTask();
+
+        explicit operator bool() const;
+        bool done() const;
+        // Runs the lookup up to its first suspension, with current
+        // tracking whichever coroutine has to be resumed next.
+        void start(std::coroutine_handle<>* current);
+
+        // Awaiting a task runs it inside the awaiting lookup.
+        bool await_ready() const { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> outer);
+        void await_resume() const {}
+};
+
+// co_await Prefetch(ptr): start loading ptr's cache line
+// and let the other lookups run while it arrives.
+struct Prefetch : std::suspend_always
+{
+    explicit Prefetch(const void* ptr) { prefetchRead(ptr); }
+};
+
+inline std::coroutine_handle<> LookupTask::promise_type::FinalAwaiter::
+await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+{
+    promise_type& promise = handle.promise();
+    if (!promise.continuation)
+        return std::noop_coroutine(); // Back to the scheduler.
+
+    *promise.current = promise.continuation;
+    return promise.continuation;
+}
+
+inline LookupTask LookupTask::promise_type::get_return_object()
+{
+    return LookupTask(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+inline PoolAllocator& LookupTask::framePool()
+{
+    // Big enough for the tables' frames; anything
+    // larger goes straight to the heap.
+    thread_local PoolAllocator pool(256);
+    return pool;
+}
+
+inline void* LookupTask::promise_type::operator new(size_t size)
+{
+    return framePool().allocate(size);
+}
+
+inline void LookupTask::promise_type::operator delete(void* ptr, size_t size)
+{
+    framePool().deallocate(ptr, size);
+}
+
+inline LookupTask::LookupTask(std::coroutine_handle<promise_type> handle) :
+    handle(handle) {}
+
+inline LookupTask::LookupTask() :
+    handle(nullptr) {}
+
+inline LookupTask::LookupTask(LookupTask&& other) :
+    handle(std::exchange(other.handle, nullptr)) {}
+
+inline LookupTask& LookupTask::operator=(LookupTask&& other)
+{
+    if (this != &other)
+    {
+        if (handle)
+            handle.destroy();
+        handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+}
+
+inline LookupTask::~LookupTask()
+{
+    if (handle)
+        handle.destroy();
+}
+
+inline LookupTask::operator bool() const
+{
+    return static_cast<bool>(handle);
+}
+
+inline bool LookupTask::done() const
+{
+    return handle.done();
+}
+
+inline void LookupTask::start(std::coroutine_handle<>* current)
+{
+    handle.promise().current = current;
+    *current = handle;
+    handle.resume();
+}
+
+inline std::coroutine_handle<> LookupTask::await_suspend(std::coroutine_handle<promise_type> outer)
+{
+    promise_type& promise = handle.promise();
+    promise.continuation = outer;
+    promise.current = outer.promise().current;
+    *promise.current = handle;
+    return handle;
+}
+
+// Most lookups interleave() keeps in flight at once.
+constexpr size_t maxLookupGroup = 64;
+
+// Runs start(0) to start(n - 1) (each returning a LookupTask),
+// keeping up to group of them in flight and resuming them
+// round-robin. A finished lookup's place goes to the next one.
+template<typename Start>
+void interleave(size_t n, size_t group, Start start)
+{
+    struct Lane
+    {
+        LookupTask task;
+        std::coroutine_handle<> current;
+    };
+
+    group = (group == 0 ? 1 : (group > maxLookupGroup ? maxLookupGroup : group));
+    Lane lanes[maxLookupGroup];
+    size_t next = 0;
+
+    // Starts lookups in lane until one suspends; false
+    // if there were none left to start.
+    auto refill = [&](Lane& lane)
+    {
+        while (next < n)
+        {
+            lane.task = start(next++);
+            lane.task.start(&lane.current);
+            if (!lane.task.done())
+                return true;
+        }
+        lane.task = LookupTask();
+        return false;
+    };
+
+    size_t active = 0;
+    for (size_t i = 0; i < group; i++)
+        active += refill(lanes[i]);
+
+    while (active > 0)
+    {
+        for (size_t i = 0; i < group; i++)
+        {
+            Lane& lane = lanes[i];
+            if (!lane.task)
+                continue;
+
+            lane.current.resume();
+            if (lane.task.done() && !refill(lane))
+                active--;
+        }
+    }
+}
+
+// out[i] = table.get(keys[i]), with up to group lookups in flight.
+template<typename Table, typename Key, typename Value>
+void interleavedGet(Table& table, const Key* keys, size_t n, Value** out, size_t group)
+{
+    interleave(n, group, [&](size_t i)
+    {
+        return table.lookupTask(keys[i], &out[i]);
+    });
+}
+#endif
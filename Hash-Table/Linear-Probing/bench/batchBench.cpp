@@ -0,0 +1,85 @@
+// Lookup throughput of get() in a loop against getBatch() and
+// containsBatch() for linearTable and robinTable, on tables
+// far bigger than the last-level cache (2^24 entries by
+// default, so a few hundred MB each). Lookups are random hits
+// and misses in equal measure, handed over a block at a time.
+
+#include "../include/linearTable.h"
+#include "../include/robinTable.h"
+#include "../../../General/benchTimer.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+static uint32_t next(uint32_t& state) // xorshift
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+template<typename Table>
+static void run(const char* name, const std::vector<int>& lookups, int n, int block)
+{
+    Table table;
+    for (int i = 0; i < n; i++)
+        table.add(i, i);
+
+    long sum = 0;
+    auto start = steady_clock::now();
+    for (size_t i = 0; i < lookups.size(); i++)
+    {
+        int* value = table.get(lookups[i]);
+        sum += (value != nullptr ? *value : -1);
+    }
+    long double getTime = elapsed(start);
+
+    std::vector<int*> values(block);
+    start = steady_clock::now();
+    for (size_t i = 0; i < lookups.size(); i += block)
+    {
+        table.getBatch(&lookups[i], block, values.data());
+        for (int j = 0; j < block; j++)
+            sum -= (values[j] != nullptr ? *values[j] : -1);
+    }
+    long double batchTime = elapsed(start);
+
+    bool* found = new bool[block];
+    start = steady_clock::now();
+    for (size_t i = 0; i < lookups.size(); i += block)
+    {
+        table.containsBatch(&lookups[i], block, found);
+        for (int j = 0; j < block; j++)
+            sum += found[j];
+    }
+    long double containsTime = elapsed(start);
+    delete[] found;
+
+    long double count = lookups.size();
+    std::cout << "  " << name << ": get " << count / getTime / 1000 << " M/s, getBatch "
+        << count / batchTime / 1000 << " M/s, containsBatch " << count / containsTime / 1000
+        << " M/s (checksum " << sum << ")\n";
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 1 << 24);
+    const int count = (argc > 2 ? std::stoi(argv[2]) : 1 << 24);
+    const int block = 1024; // Keys handed over per batch call.
+
+    // Keys below n are in the tables, the rest aren't.
+    std::vector<int> lookups(count / block * block);
+    uint32_t state = 2463534242u;
+    for (size_t i = 0; i < lookups.size(); i++)
+        lookups[i] = static_cast<int>(next(state) % (2u * n));
+
+    std::cout << n << " entries, " << lookups.size() << " lookups:\n";
+    run<linearTable<int, int>>("linearTable", lookups, n, block);
+    run<robinTable<int, int>>("robinTable ", lookups, n, block);
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Insert/delete churn at a steady size in linearTable or
+// robinTable: each round removes a random live key, adds a
+// new one and does a hit and a miss lookup (four ops).
+// Throughput is printed per block of ops, so a table that
+// degrades (longer probes as deletes pile up) shows it over
+// time. For robinTable the mean and longest probe length
+// over the live entries is printed with each block too.
+// One table per run:
+//   churnBench [linear|robin] [ops] [size]
+
+#include "../include/linearTable.h"
+#include "../include/robinTable.h"
+#include "../../../General/benchTimer.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+static uint32_t next(uint32_t& state) // xorshift
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Nothing beyond throughput for linearTable.
+static void printStart(const linearTable<int, int>&) {}
+static void printStats(const linearTable<int, int>&) {}
+
+static void printStats(const robinTable<int, int>& table)
+{
+    ProbeStats stats = table.probeStats();
+    std::cout << ", mean probe " << stats.average
+        << ", max probe " << stats.longest;
+}
+
+static void printStart(const robinTable<int, int>& table)
+{
+    std::cout << "  Start";
+    printStats(table);
+    std::cout << '\n';
+}
+
+template<typename Table>
+static void churn(long ops, int size)
+{
+    const int blocks = 10;
+
+    Table table;
+    // live[i] is a key in the table; keys only go up,
+    // so a removed key never comes back.
+    std::vector<int> live(size);
+    int nextKey = 0;
+    for (int i = 0; i < size; i++)
+    {
+        live[i] = nextKey++;
+        table.add(live[i], i);
+    }
+
+    std::cout << "Steady size " << size << ", " << ops << " ops:\n";
+    printStart(table);
+    uint32_t state = 2463534242u;
+    long sum = 0;
+    for (int block = 0; block < blocks; block++)
+    {
+        auto start = steady_clock::now();
+        for (long i = 0; i < ops / blocks / 4; i++)
+        {
+            int victim = static_cast<int>(next(state) % size);
+            table.remove(live[victim]);
+            live[victim] = nextKey++;
+            table.add(live[victim], victim);
+
+            int* hit = table.get(live[next(state) % size]);
+            sum += (hit != nullptr ? *hit : -1);
+            sum += (table.get(-1 - static_cast<int>(next(state) % size)) == nullptr);
+        }
+        long double time = elapsed(start);
+        std::cout << "  Block " << block + 1 << ": " << (ops / blocks) / time / 1000
+            << " M ops/s";
+        printStats(table);
+        std::cout << ", size " << table.size() << '\n';
+    }
+    std::cout << "Checksum: " << sum << '\n';
+}
+
+int main(int argc, char** argv)
+{
+    const std::string table = (argc > 1 ? argv[1] : "linear");
+    const long ops = (argc > 2 ? std::stol(argv[2]) : 100000000);
+    const int size = (argc > 3 ? std::stoi(argv[3]) : 1 << 16);
+
+    if (table == "linear")
+        churn<linearTable<int, int>>(ops, size);
+    else if (table == "robin")
+        churn<robinTable<int, int>>(ops, size);
+    else
+    {
+        std::cerr << "Usage: " << argv[0] << " [linear|robin] [ops] [size]\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Insert-heavy workloads on linearTable and robinTable,
+// counting probes (slots looked at) per operation: fresh
+// inserts, then a word-count style upsert done as a lookup
+// followed by an insert (what add() and set() used to do
+// inside) and as a single operator[].
+
+#define HASH_TABLE_STATS
+#include "../include/linearTable.h"
+#include "../include/robinTable.h"
+#include "../../../General/benchTimer.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+static void report(const char* name, long ops, size_t probes, long double time)
+{
+    std::cout << "    " << name << ": " << (double) probes / ops << " probes/op, "
+        << ops / time / 1000 << " M ops/s\n";
+}
+
+template<typename Table>
+static void run(const char* name, int n)
+{
+    std::cout << name << ":\n";
+
+    Table fresh;
+    auto start = steady_clock::now();
+    for (int i = 0; i < n; i++)
+        fresh.add(i, i);
+    report("add (new keys)", n, fresh.probeCount(), elapsed(start));
+
+    // Every key comes up about four times.
+    std::vector<int> words(n * 4);
+    uint32_t state = 2463534242u; // xorshift
+    for (int& word : words)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        word = static_cast<int>(state % n);
+    }
+
+    Table twoStep;
+    start = steady_clock::now();
+    for (int word : words)
+    {
+        int* count = twoStep.get(word);
+        if (count != nullptr)
+            (*count)++;
+        else
+            twoStep.add(word, 1);
+    }
+    report("get, then add", words.size(), twoStep.probeCount(), elapsed(start));
+
+    Table single;
+    start = steady_clock::now();
+    for (int word : words)
+        single[word]++;
+    report("operator[]", words.size(), single.probeCount(), elapsed(start));
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 1 << 20);
+
+    run<linearTable<int, int>>("linearTable", n);
+    run<robinTable<int, int>>("robinTable", n);
+    return 0;
+}
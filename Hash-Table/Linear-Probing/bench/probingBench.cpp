@@ -0,0 +1,67 @@
+// Insert, hit and miss throughput of linearTable, robinTable
+// and swissTable at load factors from 0.5 to 0.875 (entries
+// per slot of a 2^20-slot table). linearTable and robinTable
+// grow at 0.8, so at 0.875 they are really at half that.
+
+#include "../include/linearTable.h"
+#include "../include/robinTable.h"
+#include "../include/swissTable.h"
+#include "../../../General/benchTimer.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+template<typename Table>
+static void run(const char* name, const std::vector<int>& keys, int n, int rounds)
+{
+    Table table;
+    auto start = steady_clock::now();
+    for (int i = 0; i < n; i++)
+        table.add(keys[i], i);
+    long double insertTime = elapsed(start);
+
+    // Keys past n were never added.
+    long sum = 0;
+    start = steady_clock::now();
+    for (int round = 0; round < rounds; round++)
+        for (int i = 0; i < n; i++)
+            sum += *table.get(keys[i]);
+    long double hitTime = elapsed(start);
+
+    start = steady_clock::now();
+    for (int round = 0; round < rounds; round++)
+        for (int i = n; i < 2 * n; i++)
+            sum += (table.get(keys[i]) == nullptr);
+    long double missTime = elapsed(start);
+
+    long double lookups = (long double) n * rounds;
+    std::cout << "  " << name << ": insert " << n / insertTime / 1000 << " M/s, hit "
+        << lookups / hitTime / 1000 << " M/s, miss " << lookups / missTime / 1000
+        << " M/s (checksum " << sum << ")\n";
+}
+
+int main(int argc, char** argv)
+{
+    const int slots = (argc > 1 ? std::stoi(argv[1]) : 1 << 20);
+    const int rounds = 3;
+
+    // Distinct keys in a scattered order (multiplying by
+    // an odd number never maps two ints to the same one).
+    std::vector<int> keys(2 * slots);
+    for (int i = 0; i < 2 * slots; i++)
+        keys[i] = static_cast<int>((uint32_t) i * 2654435761u);
+
+    for (double load : {0.5, 0.625, 0.75, 0.875})
+    {
+        int n = static_cast<int>(slots * load);
+        std::cout << "Load factor " << load << " (" << n << " entries):\n";
+        run<linearTable<int, int>>("linearTable", keys, n, rounds);
+        run<robinTable<int, int>>("robinTable ", keys, n, rounds);
+        run<swissTable<int, int>>("swissTable ", keys, n, rounds);
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+// Time spent growing a robinTable with std::string keys.
+// Keys are added one by one up to the given count; every add
+// that makes the table grow is timed on its own (the growth
+// rule is mirrored here, since the table doesn't expose its
+// capacity). Prints the slowest resize, the total time spent
+// resizing and the peak resident set size of the process.
+
+#include "../include/robinTable.h"
+#include "../../../General/benchTimer.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+
+using namespace std::chrono;
+
+int main(int argc, char** argv)
+{
+    const long n = (argc > 1 ? std::stol(argv[1]) : 50000000);
+
+    robinTable<std::string, int> table;
+    size_t capacity = 2; // A new table's.
+    long double resizeTime = 0;
+    long double worst = 0;
+    int resizes = 0;
+
+    auto start = steady_clock::now();
+    for (long i = 0; i < n; i++)
+    {
+        // Short enough to stay in the string's inline buffer,
+        // so moving a key doesn't skip any real copying work.
+        std::string key = "key" + std::to_string(i);
+        if (capacity * 0.8 < i + 1)
+        {
+            auto resizeStart = steady_clock::now();
+            table.add(key, static_cast<int>(i));
+            long double time = elapsed(resizeStart);
+            resizeTime += time;
+            worst = (time > worst ? time : worst);
+            resizes++;
+            capacity *= 2;
+        }
+        else
+            table.add(key, static_cast<int>(i));
+    }
+    long double total = elapsed(start);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::cout << n << " std::string keys, " << capacity << " slots:\n";
+    std::cout << "  Total: " << total << " ms\n";
+    std::cout << "  Resizing: " << resizeTime << " ms over " << resizes
+        << " resizes, slowest " << worst << " ms\n";
+    std::cout << "  Peak RSS: " << usage.ru_maxrss / 1024 << " MB\n";
+    return 0;
+}
@@ -1,14 +1,16 @@
 /*  This hash table has a basic implementation of open addressing to deal with hash collisions.
 *   It uses linear probing (rather than quadratic probing or similar alternatives) to traverse through the array upon
 *   collisions.
-*   Deletions are dealt with using tombstones rather than back-shifting (or other methods), and the main structure is an
-*   AOS (array of structs).
+*   Deletions use backward shifting rather than tombstones: the entries after a removed one are moved back into the
+*   hole when that keeps them reachable from their home slot, so probes never have to walk over dead slots and the
+*   table doesn't fill up with them under churn. The main structure is an AOS (array of structs).
 */
 
 #pragma once
 #include "../../../Dynamic-Array/include/array.h"
 #include "../../General/entryStruct.h"
 #include "../../General/hashFunctions.h"
+#include "../../General/lookupTask.h"
 #include <cstdint>
 #include <iostream> // For debugging.
 
@@ -25,29 +27,74 @@ class linearTable
         Array<EKV> entries;
         int count;
         int maxIndex;
+#ifdef HASH_TABLE_STATS
+        size_t probes = 0; // Slots looked at by every search so far.
+#endif
 
-        linearTable(int size);
+        linearTable(int size, Allocator* alloc);
 
-        void reorder();
+        void reorder(size_t capacity);
         void resize();
+        // Empties slot index, pulling later entries of
+        // the same run back so none of them is cut off.
+        void shiftBack(int index);
         // Searches for existing key.
-        // Returns reference to available bucket
-        // if not found.
-        EKV& findSlot(Key key, int* pos);
+        // Returns reference to the empty slot
+        // ending the probe if not found.
+        // K is Key, or std::string_view for a transparent lookup.
+        template<typename K>
+        EKV& findSlot(const K& key, Hash hash, int* pos);
+        template<typename K>
+        InsertResult<Value> insertKey(const K& key);
+        // Looks up n keys, calling found(i, entry) for each
+        // (entry is nullptr for a missing key).
+        template<typename Found>
+        void findBatch(const Key* batch, size_t n, Found found);
     
     public:
         linearTable();
+        explicit linearTable(Allocator* alloc);
         linearTable(const linearTable<Key, Value>& other);
         ~linearTable() = default;
         linearTable<Key, Value>& operator=(const linearTable<Key, Value>& other);
         Value& operator[](Key key);
 
+        // Hashes the key once and probes once (twice only if the
+        // table has to grow), adding it with a Value() if missing.
+        InsertResult<Value> findOrInsert(Key key);
         void add(Key key, Value value);
         Value* get(Key key);
+        // Batched lookups: out[i] is what get(batch[i]) (or contains)
+        // would return. Keys are hashed and their home slots fetched
+        // a few at a time before probing, so the cache misses on a
+        // large table overlap instead of stalling one after another.
+        void getBatch(const Key* batch, size_t n, Value** out);
+        void containsBatch(const Key* batch, size_t n, bool* out);
+#ifdef __cpp_impl_coroutine
+        // One get() as a coroutine for interleave() (C++20 only):
+        // sets *out to the value, or nullptr if key isn't there.
+        LookupTask lookupTask(Key key, Value** out);
+#endif
         void set(Key key, Value value);
         void remove(Key key);
+        // Transparent lookups: a table keyed by std::string (or
+        // std::string_view) also takes anything that converts to a
+        // std::string_view, without building a Key to look it up.
+        template<typename K, typename = TransparentKey<Key, K>>
+        InsertResult<Value> findOrInsert(const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        Value& operator[](const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        Value* get(const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        void set(const K& key, Value value);
+        template<typename K, typename = TransparentKey<Key, K>>
+        void remove(const K& key);
         void merge(const linearTable<Key, Value>& other);
         int size();
+#ifdef HASH_TABLE_STATS
+        size_t probeCount() const;
+#endif
 
         // For debugging.
         void printTable();
@@ -55,7 +102,14 @@ class linearTable
 
 KVTEMP
 linearTable<Key, Value>::linearTable() :
-    entries(2), count(0), maxIndex(-1) {}
+    linearTable(defaultAllocator()) {}
+
+KVTEMP
+linearTable<Key, Value>::linearTable(Allocator* alloc) :
+    entries(2, alloc), count(0), maxIndex(-1)
+{
+    entries.fillArray(EKV(), true); // Mark every slot as empty.
+}
 
 KVTEMP
 linearTable<Key, Value>::linearTable(const linearTable<Key, Value>& other) :
@@ -63,22 +117,26 @@ linearTable<Key, Value>::linearTable(const linearTable<Key, Value>& other) :
     maxIndex(other.maxIndex) {}
 
 KVTEMP
-linearTable<Key, Value>::linearTable(int size) :
-    entries(size), count(0), maxIndex(-1) {}
+linearTable<Key, Value>::linearTable(int size, Allocator* alloc) :
+    entries(size, alloc), count(0), maxIndex(-1)
+{
+    entries.fillArray(EKV(), true);
+}
 
 KVTEMP
 linearTable<Key, Value>& linearTable<Key, Value>::
 operator=(const linearTable<Key, Value>& other)
 {
     this->entries = other.entries;
+    this->count = other.count;
+    this->maxIndex = other.maxIndex;
     return *this;
 }
 
 KVTEMP
-void linearTable<Key, Value>::reorder()
+void linearTable<Key, Value>::reorder(size_t capacity)
 {
-    size_t capacity = entries.capacity();
-    linearTable<Key, Value> newTable(static_cast<int>(capacity));
+    linearTable<Key, Value> newTable(static_cast<int>(capacity), entries.allocator());
     for (size_t i = 0; i < maxIndex + 1; i++)
     {
         EKV entry = entries.slot((int) i);
@@ -87,7 +145,7 @@ void linearTable<Key, Value>::reorder()
         newTable.add(entry.key, entry.value);
     }
     this->entries = newTable.entries;
-    this->count = newTable.count; // Might have changed since we dropped tombstones.
+    this->count = newTable.count;
     this->maxIndex = newTable.maxIndex;
 }
 
@@ -97,75 +155,111 @@ void linearTable<Key, Value>::resize()
     if ((entries.capacity() * loadFactor) < count + 1)
     {
         if (count == 0)
-            entries.grow();
-        else
         {
-            entries.increaseCapacity();
-            reorder();
+            entries.grow();
+            entries.fillArray(EKV(), true);
         }
+        else
+            reorder(entries.capacity() * 2);
     }
 }
 
 KVTEMP
-EKV& linearTable<Key, Value>::findSlot(Key key, int* pos)
+template<typename K>
+EKV& linearTable<Key, Value>::findSlot(const K& key, Hash hash, int* pos)
 {
-    uint32_t hash = hashKey(key);
     uint32_t bitmask = (uint32_t) (entries.capacity() - 1);
     int index = (int) (hash & bitmask);
 
-    EKV* tombstone = nullptr;
-
+    // No tombstones, so the first empty slot ends the search.
     EKV* entry = &(entries.slot(index));
-    if (pos != nullptr)
-        *pos = index;
     while (entry->state != EMPTY)
     {
-        if (pos != nullptr)
-            *pos = index;
-        
-        if (entry->key == key)
-            return *entry;
-        
-        if (entry->state == TOMBSTONE)
-            tombstone = entry;
+#ifdef HASH_TABLE_STATS
+        probes++;
+#endif
+        if ((entry->hash == hash) && (entry->key == key))
+            break;
 
         index = (index + 1) & bitmask;
-        if (pos != nullptr)
-            *pos = index;
         entry = &(entries.slot(index));
     }
 
-    // We didn't find an entry with the key.
-    // If we found a tombstone, return it (to reuse it).
-    // Otherwise, return the first empty slot we found.
-    return (tombstone == nullptr ? *entry : *tombstone);
+    if (pos != nullptr)
+        *pos = index;
+    return *entry;
 }
 
 KVTEMP
-void linearTable<Key, Value>::add(Key key, Value value)
+template<typename K>
+InsertResult<Value> linearTable<Key, Value>::insertKey(const K& key)
 {
-    EKV& existEntry = findSlot(key, nullptr);
-    if (existEntry.state == VALID) // Key already exists.
+    Hash hash = hashKey(key);
+    int index;
+    EKV* entry = &findSlot(key, hash, &index);
+    if (entry->state == VALID)
+        return {entry->value, false};
+
+    if ((entries.capacity() * loadFactor) < count + 1)
     {
-        existEntry.value = value;
-        return;
+        // Growing moves everything, so look again.
+        resize();
+        entry = &findSlot(key, hash, &index);
     }
 
-    resize(); // Grow size if needed.
+    count++;
+    entry->key = Key(key);
+    entry->value = Value();
+    entry->hash = hash;
+    entry->state = VALID;
 
-    uint32_t hash = hashKey(key);
-    int index;
-    EKV& newEntry = findSlot(key, &index);
+    maxIndex = (maxIndex > index ? maxIndex : index);
+    return {entry->value, true};
+}
 
-    if (newEntry.state != TOMBSTONE)
-        count++;
+KVTEMP
+void linearTable<Key, Value>::shiftBack(int index)
+{
+    uint32_t bitmask = (uint32_t) (entries.capacity() - 1);
+    int hole = index;
+    int next = (hole + 1) & bitmask;
 
-    newEntry.key = key;
-    newEntry.value = value;
-    newEntry.hash = hash;
-    newEntry.state = VALID;
+    while (entries.slot(next).state != EMPTY)
+    {
+        EKV& entry = entries.slot(next);
+        int home = (int) (entry.hash & bitmask);
+        // The entry can fill the hole unless its home slot lies
+        // after the hole (then the hole isn't on its probe path).
+        if (((next - home) & bitmask) >= ((next - hole) & bitmask))
+        {
+            entries.slot(hole) = std::move(entry);
+            maxIndex = (maxIndex > hole ? maxIndex : hole); // Wrapped around.
+            hole = next;
+        }
+        next = (next + 1) & bitmask;
+    }
 
-    maxIndex = (maxIndex > index ? maxIndex : index);
+    entries.slot(hole).state = EMPTY;
+}
+
+KVTEMP
+InsertResult<Value> linearTable<Key, Value>::findOrInsert(Key key)
+{
+    return insertKey(key);
+}
+
+KVTEMP
+Value& linearTable<Key, Value>::operator[](Key key)
+{
+    return insertKey(key).value;
+}
+
+// add() and set() do the same thing now: both
+// overwrite the value of a key that's already there.
+KVTEMP
+void linearTable<Key, Value>::add(Key key, Value value)
+{
+    insertKey(key).value = value;
 }
 
 KVTEMP
@@ -173,29 +267,161 @@ Value* linearTable<Key, Value>::get(Key key)
 {
     if (count == 0) return nullptr;
     
-    EKV& entry = findSlot(key, nullptr);
+    EKV& entry = findSlot(key, hashKey(key), nullptr);
     if (entry.state != VALID)
         return nullptr;
     else
         return &(entry.value);
 }
 
+KVTEMP
+template<typename Found>
+void linearTable<Key, Value>::findBatch(const Key* batch, size_t n, Found found)
+{
+    if (count == 0)
+    {
+        for (size_t i = 0; i < n; i++)
+            found(i, nullptr);
+        return;
+    }
+
+    uint32_t bitmask = (uint32_t) (entries.capacity() - 1);
+    Hash batchHashes[lookupBatch];
+    for (size_t start = 0; start < n; start += lookupBatch)
+    {
+        size_t end = (n < start + lookupBatch ? n : start + lookupBatch);
+        for (size_t i = start; i < end; i++)
+        {
+            Hash hash = hashKey(batch[i]);
+            batchHashes[i - start] = hash;
+            prefetchRead(&entries.slot((int) (hash & bitmask)));
+        }
+
+        for (size_t i = start; i < end; i++)
+        {
+            EKV& entry = findSlot(batch[i], batchHashes[i - start], nullptr);
+            found(i, (entry.state == VALID ? &entry : nullptr));
+        }
+    }
+}
+
+KVTEMP
+void linearTable<Key, Value>::getBatch(const Key* batch, size_t n, Value** out)
+{
+    findBatch(batch, n, [out](size_t i, EKV* entry)
+    {
+        out[i] = (entry == nullptr ? nullptr : &(entry->value));
+    });
+}
+
+KVTEMP
+void linearTable<Key, Value>::containsBatch(const Key* batch, size_t n, bool* out)
+{
+    findBatch(batch, n, [out](size_t i, EKV* entry)
+    {
+        out[i] = (entry != nullptr);
+    });
+}
+
+#ifdef __cpp_impl_coroutine
+KVTEMP
+LookupTask linearTable<Key, Value>::lookupTask(Key key, Value** out)
+{
+    *out = nullptr;
+    if (count == 0)
+        co_return;
+
+    Hash hash = hashKey(key);
+    uint32_t bitmask = (uint32_t) (entries.capacity() - 1);
+    int index = (int) (hash & bitmask);
+    EKV* entry = &(entries.slot(index));
+    co_await Prefetch(entry);
+
+    while (entry->state != EMPTY)
+    {
+        if ((entry->hash == hash) && (entry->key == key))
+        {
+            *out = &(entry->value);
+            co_return;
+        }
+
+        index = (index + 1) & bitmask;
+        entry = &(entries.slot(index));
+        // Only wait again when the probe runs into a new cache line.
+        if ((reinterpret_cast<uintptr_t>(entry) & 63) < sizeof(EKV))
+            co_await Prefetch(entry);
+    }
+}
+#endif
+
 KVTEMP
 void linearTable<Key, Value>::set(Key key, Value value)
 {
-    EKV& entry = findSlot(key, nullptr);
+    insertKey(key).value = value;
+}
+
+KVTEMP
+void linearTable<Key, Value>::remove(Key key)
+{
+    int index;
+    EKV& entry = findSlot(key, hashKey(key), &index);
+    if (entry.state == VALID) // Leave it if it's already empty.
+    {
+        shiftBack(index);
+        count--;
+    }
+}
+
+// Transparent lookups go through a std::string_view,
+// so a const char* is only measured once.
+
+KVTEMP
+template<typename K, typename>
+InsertResult<Value> linearTable<Key, Value>::findOrInsert(const K& key)
+{
+    return insertKey(std::string_view(key));
+}
+
+KVTEMP
+template<typename K, typename>
+Value& linearTable<Key, Value>::operator[](const K& key)
+{
+    return insertKey(std::string_view(key)).value;
+}
+
+KVTEMP
+template<typename K, typename>
+Value* linearTable<Key, Value>::get(const K& key)
+{
+    if (count == 0) return nullptr;
+    
+    std::string_view view(key);
+    EKV& entry = findSlot(view, hashKey(view), nullptr);
     if (entry.state != VALID)
-        add(key, value);
+        return nullptr;
     else
-        entry.value = value;
+        return &(entry.value);
 }
 
 KVTEMP
-void linearTable<Key, Value>::remove(Key key)
+template<typename K, typename>
+void linearTable<Key, Value>::set(const K& key, Value value)
+{
+    insertKey(std::string_view(key)).value = value;
+}
+
+KVTEMP
+template<typename K, typename>
+void linearTable<Key, Value>::remove(const K& key)
 {
-    EKV& entry = findSlot(key, nullptr);
+    std::string_view view(key);
+    int index;
+    EKV& entry = findSlot(view, hashKey(view), &index);
     if (entry.state == VALID) // Leave it if it's already empty.
-        entry.state = TOMBSTONE;
+    {
+        shiftBack(index);
+        count--;
+    }
 }
 
 KVTEMP
@@ -216,6 +442,14 @@ int linearTable<Key, Value>::size()
     return count;
 }
 
+#ifdef HASH_TABLE_STATS
+KVTEMP
+size_t linearTable<Key, Value>::probeCount() const
+{
+    return probes;
+}
+#endif
+
 KVTEMP
 void linearTable<Key, Value>::printTable()
 {
@@ -227,13 +461,7 @@ void linearTable<Key, Value>::printTable()
         if (entry.state == EMPTY)
             std::cout << "EMPTY\n";
         else
-        {
             std::cout << "(" << entry.key << ", "
-                << entry.value << ")";
-            if (entry.state == TOMBSTONE)
-                std::cout << " (TOMB)\n";
-            else
-                std::cout << '\n';
-        }
+                << entry.value << ")\n";
     }
 }
\ No newline at end of file
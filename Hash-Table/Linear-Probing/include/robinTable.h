@@ -1,25 +1,37 @@
-/*  This hash table uses open addressing with linear probing and tombstones for deletion, as in the linearTable 
-*   container class.
-*   However, it additionally includes two optimizations:
+/*  This hash table uses open addressing with linear probing, as in the linearTable container class.
+*   However, it additionally includes three optimizations:
 *   1. Robin Hood hashing, where we shift entries with shorter probe distances from their expected slot back to insert
 *      new entries whose current probe is further than that from *its* expected slot. This causes most probe distances
 *      to average out, improving average performance and reducing worst-case degradation.
-*   2. SOA structure, where we split the states, hashes, keys, and values into separate arrays. Since most of our
-*      searching work or traversal is over the states and hashes, it is more cache friendly to store them in their own
-*      arrays where they would be more densely packed. Keys and values are then only accessed if necessary, and directly
-*      by index.
+*   2. SOA structure, where we split the probe lengths, hashes, keys, and values into separate arrays. Since most of
+*      our searching work or traversal is over the probe lengths and hashes, it is more cache friendly to store them in
+*      their own arrays where they would be more densely packed. Keys and values are then only accessed if necessary,
+*      and directly by index.
+*      Each slot's probe length (1 for an entry in its home slot, 0 for an empty slot) takes a single byte, so a search
+*      can tell when to stop, and which slots could hold its key, without looking at the hashes at all. Lengths past
+*      what a byte holds are saturated and worked out from the hash instead.
+*   3. Backward-shift deletion instead of tombstones. Removing an entry pulls the entries after it (up to an empty
+*      slot or one already in its home slot) back by one, so every probe sequence stays as short as if the removed
+*      key had never been added, and lookups can keep stopping early at the first "richer" entry.
 */
 
 #pragma once
 #include "../../../Dynamic-Array/include/array.h"
 #include "../../General/entryStruct.h"
 #include "../../General/hashFunctions.h"
+#include "../../General/lookupTask.h"
 #include <algorithm>
 #include <cstdint>
 #include <iostream> // For debugging.
 
 #define KVTEMP template<typename Key, typename Value>
 
+struct ProbeStats
+{
+    int longest; // Probe length of the worst-placed entry.
+    double average; // Mean probe length over the entries.
+};
+
 KVTEMP
 class robinTable
 {
@@ -27,33 +39,95 @@ class robinTable
         // Keeping the same load factor for 
         // all implementations.
         static constexpr double loadFactor = 0.8;
-        Array<EntryState> states;
+        // Stored lengths stop here; longer ones come from the hash.
+        static constexpr int maxLength = UINT8_MAX;
+        Array<uint8_t> lengths; // Probe length per slot; 0 if empty.
         Array<Hash> hashes;
         Array<Key> keys;
         Array<Value> values;
         size_t count;
         int maxIndex;
+#ifdef HASH_TABLE_STATS
+        size_t probes = 0; // Slots looked at by every search so far.
+#endif
 
-        robinTable(size_t size);
+        robinTable(size_t size, Allocator* alloc);
 
-        void reorder();
+        // Moves every entry into new columns of the given
+        // capacity, placing them by their stored hashes.
+        void reorder(size_t capacity);
         void resize();
-        int findSlot(Key key);
-        inline void insertPair(Key key, Value value, Hash hash, int index);
+        // K is Key, or std::string_view for a transparent lookup.
+        template<typename K>
+        int findSlot(const K& key, Hash hash);
+        // Where key is (found set), or else where it belongs:
+        // a free slot, or the entry it should displace, with
+        // its probe length there in length.
+        template<typename K>
+        int probeSlot(const K& key, Hash hash, bool* found, int* length);
+        template<typename K>
+        InsertResult<Value> insertKey(const K& key);
+        // Probe length of the entry at index (0 if empty).
+        inline int lengthAt(int index);
+        inline void setLength(int index, int length);
+        inline void insertPair(Key key, Value value, Hash hash, int index, int length);
+        // Robin Hood insertion starting at index, where the
+        // entry's probe length would be length.
+        void carry(Key key, Value value, Hash hash, int index, int length);
+        // Empties index and moves the run after it back a slot.
+        void shiftBack(int index);
+        // Looks up n keys, calling found(i, slot) for each
+        // (slot is -1 for a missing key).
+        template<typename Found>
+        void findBatch(const Key* batch, size_t n, Found found);
     
     public:
         robinTable();
+        // All four columns are allocated from alloc.
+        explicit robinTable(Allocator* alloc);
         robinTable(const robinTable<Key, Value>& other);
         ~robinTable() = default;
         robinTable<Key, Value>& operator=(const robinTable<Key, Value>& other);
         Value& operator[](Key key);
 
+        // Hashes the key once and probes once (twice only if the
+        // table has to grow), adding it with a Value() if missing.
+        InsertResult<Value> findOrInsert(Key key);
         void add(Key key, Value value);
         Value* get(Key key);
+        // Batched lookups: out[i] is what get(batch[i]) (or contains)
+        // would return. Keys are hashed and their home slots fetched
+        // a few at a time before probing, so the cache misses on a
+        // large table overlap instead of stalling one after another.
+        void getBatch(const Key* batch, size_t n, Value** out);
+        void containsBatch(const Key* batch, size_t n, bool* out);
+#ifdef __cpp_impl_coroutine
+        // One get() as a coroutine for interleave() (C++20 only):
+        // sets *out to the value, or nullptr if key isn't there.
+        LookupTask lookupTask(Key key, Value** out);
+#endif
         void set(Key key, Value value);
         void remove(Key key);
+        // Transparent lookups: a table keyed by std::string (or
+        // std::string_view) also takes anything that converts to a
+        // std::string_view, without building a Key to look it up.
+        template<typename K, typename = TransparentKey<Key, K>>
+        InsertResult<Value> findOrInsert(const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        Value& operator[](const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        Value* get(const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        void set(const K& key, Value value);
+        template<typename K, typename = TransparentKey<Key, K>>
+        void remove(const K& key);
         void merge(const robinTable<Key, Value>& other);
         size_t size();
+        // A probe length of 1 means the entry sits in its home slot.
+        ProbeStats probeStats() const;
+#ifdef HASH_TABLE_STATS
+        size_t probeCount() const;
+#endif
 
         // For debugging.
         void printTable();
@@ -61,23 +135,28 @@ class robinTable
 
 KVTEMP
 robinTable<Key, Value>::robinTable() :
-    hashes(2), keys(2), values(2), states(2),
-    count(0), maxIndex(-1)
-{
-    states.fillArray(EMPTY, true); // Mark every slot as empty.
-}
+    robinTable(2, defaultAllocator()) {}
+
+KVTEMP
+robinTable<Key, Value>::robinTable(Allocator* alloc) :
+    robinTable(2, alloc) {}
 
 KVTEMP
 robinTable<Key, Value>::robinTable(const robinTable<Key, Value>& other) :
-    hashes(other.hashes), keys(other.keys), values(other.values),
-    states(other.states), count(other.count), maxIndex(other.maxIndex) {}
+    lengths(other.lengths), hashes(other.hashes), keys(other.keys),
+    values(other.values), count(other.count), maxIndex(other.maxIndex) {}
 
 KVTEMP
-robinTable<Key, Value>::robinTable(size_t size) :
-    hashes(size), keys(size), values(size),
-    states(size), count(0), maxIndex(-1)
+robinTable<Key, Value>::robinTable(size_t size, Allocator* alloc) :
+    lengths(size, alloc), hashes(size, alloc), keys(size, alloc),
+    values(size, alloc), count(0), maxIndex(-1)
 {
-    states.fillArray(EMPTY, true);
+    // The Arrays only construct what we fill,
+    // so every column is filled up to capacity.
+    lengths.fillArray(0, true); // Mark every slot as empty.
+    hashes.fillArray(0, true);
+    keys.fillArray(Key(), true);
+    values.fillArray(Value(), true);
 }
 
 KVTEMP
@@ -87,134 +166,252 @@ operator=(const robinTable<Key, Value>& other)
     this->hashes = other.hashes;
     this->keys = other.keys;
     this->values = other.values;
-    this->states = other.states;
+    this->lengths = other.lengths;
     this->count = other.count;
     this->maxIndex = other.maxIndex;
+    return *this;
 }
 
 KVTEMP
-void robinTable<Key, Value>::reorder()
+void robinTable<Key, Value>::reorder(size_t capacity)
 {
-    size_t capacity = states.capacity();
-    robinTable<Key, Value> newTable(capacity);
+    robinTable<Key, Value> newTable(capacity, lengths.allocator());
+    size_t bitmask = capacity - 1;
     for (size_t i = 0; i < maxIndex + 1; i++)
     {
-        EntryState state = states.slot(i);
-        if (state != VALID)
+        if (lengths.slot(i) == 0)
             continue;
-        newTable.add(keys.slot(i), values.slot(i));
+        // The keys are already known to be distinct, so
+        // there's nothing to search for: just place them.
+        Hash hash = hashes.slot(i);
+        newTable.carry(std::move(keys.slot(i)), std::move(values.slot(i)),
+            hash, hash & bitmask, 1);
     }
 
-    this->hashes = newTable.hashes;
-    this->keys = newTable.keys;
-    this->values = newTable.values;
-    this->states = newTable.states;
-    this->count = newTable.count; // Might have changed since we dropped tombstones.
+    this->hashes = std::move(newTable.hashes);
+    this->keys = std::move(newTable.keys);
+    this->values = std::move(newTable.values);
+    this->lengths = std::move(newTable.lengths);
+    this->count = newTable.count;
     this->maxIndex = newTable.maxIndex;
 }
 
 KVTEMP
 void robinTable<Key, Value>::resize()
 {   
-    if ((states.capacity() * loadFactor) < count + 1)
+    if ((lengths.capacity() * loadFactor) < count + 1)
     {
         if (count == 0)
         {
             hashes.grow();
             keys.grow();
             values.grow();
-            states.grow();
+            lengths.grow();
+            hashes.fillArray(0, true);
+            keys.fillArray(Key(), true);
+            values.fillArray(Value(), true);
+            lengths.fillArray(0, true);
         }
         else
-        {
-            hashes.increaseCapacity();
-            keys.increaseCapacity();
-            values.increaseCapacity();
-            states.increaseCapacity();
-            reorder();
-        }
+            reorder(lengths.capacity() * 2);
     }
 }
 
 KVTEMP
-int robinTable<Key, Value>::findSlot(Key key)
+inline int robinTable<Key, Value>::lengthAt(int index)
+{
+    int length = lengths.slot(index);
+    if (length != maxLength)
+        return length;
+
+    size_t bitmask = hashes.capacity() - 1;
+    return ((index - hashes.slot(index)) & bitmask) + 1;
+}
+
+KVTEMP
+inline void robinTable<Key, Value>::setLength(int index, int length)
+{
+    lengths.slot(index) = (uint8_t) (length < maxLength ? length : maxLength);
+}
+
+KVTEMP
+template<typename K>
+int robinTable<Key, Value>::findSlot(const K& key, Hash hash)
 {
-    Hash hash = hashKey(key);
     size_t bitmask = hashes.capacity() - 1;
     int index = hash & bitmask;
-    int distance = 0; // Our probe distance while searching for this key.
+    int length = 1; // Our probe length while searching for this key.
 
-    EntryState state = states.slot(index);
-    while (state != EMPTY)
+    while (true)
     {
-        int origSlot = hashes.slot(index) & bitmask; // Expected slot for current entry.
-        int currentDiff = index - origSlot +
-            (index < origSlot ? hashes.capacity() : 0); // Probe distance for current entry.
-        if (currentDiff < distance)
-            break;
-        
-        if ((hashes.slot(index) == hash) && (keys.slot(index) == key))
+#ifdef HASH_TABLE_STATS
+        probes++;
+#endif
+        int current = lengthAt(index);
+        // An empty slot, or an entry closer to home than
+        // we are: the key would have been placed before it.
+        if (current < length)
+            return -1;
+
+        // Only an entry with our home slot can be our key,
+        // and it would be exactly as far along as we are.
+        if ((current == length) && (hashes.slot(index) == hash) && (keys.slot(index) == key))
             return index;
-        
+
         index = (index + 1) & bitmask;
-        state = states.slot(index);
-        distance++;
+        length++;
     }
+}
+
+KVTEMP
+template<typename K>
+int robinTable<Key, Value>::probeSlot(const K& key, Hash hash, bool* found, int* length)
+{
+    size_t bitmask = hashes.capacity() - 1;
+    int index = hash & bitmask;
 
-    return -1;
+    *found = false;
+    *length = 1;
+    while (true)
+    {
+#ifdef HASH_TABLE_STATS
+        probes++;
+#endif
+        int current = lengthAt(index);
+        if (current < *length) // Empty, or the key would have been here.
+            return index;
+
+        if ((current == *length) && (hashes.slot(index) == hash) && (keys.slot(index) == key))
+        {
+            *found = true;
+            return index;
+        }
+
+        index = (index + 1) & bitmask;
+        (*length)++;
+    }
 }
 
 KVTEMP
-inline void robinTable<Key, Value>::insertPair(Key key, Value value, Hash hash, int index)
+inline void robinTable<Key, Value>::insertPair(Key key, Value value, Hash hash, int index, int length)
 {
-    keys.slot(index) = key;
-    values.slot(index) = value;
+    keys.slot(index) = std::move(key);
+    values.slot(index) = std::move(value);
     hashes.slot(index) = hash;
-    if (states.slot(index) != TOMBSTONE)
-        count++;
-    states.slot(index) = VALID;
+    setLength(index, length);
+    count++;
     maxIndex = (index > maxIndex ? index : maxIndex);
 }
 
 KVTEMP
-void robinTable<Key, Value>::add(Key key, Value value)
+void robinTable<Key, Value>::carry(Key key, Value value, Hash hash, int index, int length)
 {
-    int slot = findSlot(key);
-    if (slot != -1)
-    {
-        values.slot(slot) = value;
-        return;
-    }
-
-    resize();
-
-    Hash hash = hashKey(key);
     size_t bitmask = hashes.capacity() - 1;
-    int index = hash & bitmask;
-    int distance = 0;
-
     while (true)
     {
-        if (states.slot(index) != VALID)
+        int current = lengthAt(index);
+        if (current == 0)
         {
-            insertPair(key, value, hash, index);
+            insertPair(std::move(key), std::move(value), hash, index, length);
             return;
         }
 
-        int origSlot = hashes.slot(index) & bitmask; // Expected slot for current entry.
-        int currentDiff = index - origSlot +
-            (index < origSlot ? hashes.capacity() : 0); // Probe distance for current entry.
-        if (currentDiff < distance)
+        if (current < length)
         {
             std::swap(key, keys.slot(index));
             std::swap(value, values.slot(index));
             std::swap(hash, hashes.slot(index));
-            distance = currentDiff;
+            setLength(index, length);
+            length = current;
         }
 
         index = (index + 1) & bitmask;
-        distance++;
+        length++;
+    }
+}
+
+KVTEMP
+template<typename K>
+InsertResult<Value> robinTable<Key, Value>::insertKey(const K& key)
+{
+    Hash hash = hashKey(key);
+    bool found;
+    int length;
+    int index = probeSlot(key, hash, &found, &length);
+    if (found)
+        return {values.slot(index), false};
+
+    if ((lengths.capacity() * loadFactor) < count + 1)
+    {
+        // Growing moves everything, so look again.
+        resize();
+        index = probeSlot(key, hash, &found, &length);
     }
+
+    int current = lengthAt(index);
+    if (current == 0)
+        insertPair(Key(key), Value(), hash, index, length);
+    else
+    {
+        // Take the richer entry's slot and push it further along.
+        size_t bitmask = hashes.capacity() - 1;
+        Key evictedKey = std::move(keys.slot(index));
+        Value evictedValue = std::move(values.slot(index));
+        Hash evictedHash = hashes.slot(index);
+        keys.slot(index) = Key(key);
+        values.slot(index) = Value();
+        hashes.slot(index) = hash;
+        setLength(index, length);
+        carry(std::move(evictedKey), std::move(evictedValue), evictedHash,
+            (index + 1) & bitmask, current + 1);
+    }
+
+    return {values.slot(index), true};
+}
+
+KVTEMP
+void robinTable<Key, Value>::shiftBack(int index)
+{
+    size_t bitmask = hashes.capacity() - 1;
+    int hole = index;
+    int next = (hole + 1) & bitmask;
+
+    // Every entry in the run after the hole is at least one slot
+    // from home, so each can move back one; the run ends at an
+    // empty slot or at an entry already in its home slot.
+    while (lengths.slot(next) > 1)
+    {
+        keys.slot(hole) = std::move(keys.slot(next));
+        values.slot(hole) = std::move(values.slot(next));
+        hashes.slot(hole) = hashes.slot(next);
+        setLength(hole, lengthAt(next) - 1);
+        maxIndex = (maxIndex > hole ? maxIndex : hole); // Wrapped around.
+        hole = next;
+        next = (next + 1) & bitmask;
+    }
+
+    lengths.slot(hole) = 0;
+    count--;
+}
+
+KVTEMP
+InsertResult<Value> robinTable<Key, Value>::findOrInsert(Key key)
+{
+    return insertKey(key);
+}
+
+KVTEMP
+Value& robinTable<Key, Value>::operator[](Key key)
+{
+    return insertKey(key).value;
+}
+
+// add() and set() do the same thing now: both
+// overwrite the value of a key that's already there.
+KVTEMP
+void robinTable<Key, Value>::add(Key key, Value value)
+{
+    insertKey(key).value = value;
 }
 
 KVTEMP
@@ -222,29 +419,139 @@ Value* robinTable<Key, Value>::get(Key key)
 {
     if (count == 0) return nullptr;
     
-    int slot = findSlot(key);
+    int slot = findSlot(key, hashKey(key));
     if (slot == -1)
         return nullptr;
     else
         return &values.slot(slot);
 }
 
+KVTEMP
+template<typename Found>
+void robinTable<Key, Value>::findBatch(const Key* batch, size_t n, Found found)
+{
+    if (count == 0)
+    {
+        for (size_t i = 0; i < n; i++)
+            found(i, -1);
+        return;
+    }
+
+    size_t bitmask = hashes.capacity() - 1;
+    Hash batchHashes[lookupBatch];
+    for (size_t start = 0; start < n; start += lookupBatch)
+    {
+        size_t end = std::min(n, start + lookupBatch);
+        for (size_t i = start; i < end; i++)
+        {
+            Hash hash = hashKey(batch[i]);
+            int home = hash & bitmask;
+            batchHashes[i - start] = hash;
+            prefetchRead(&lengths.slot(home));
+            prefetchRead(&hashes.slot(home));
+            prefetchRead(&keys.slot(home));
+        }
+
+        for (size_t i = start; i < end; i++)
+            found(i, findSlot(batch[i], batchHashes[i - start]));
+    }
+}
+
+KVTEMP
+void robinTable<Key, Value>::getBatch(const Key* batch, size_t n, Value** out)
+{
+    findBatch(batch, n, [this, out](size_t i, int slot)
+    {
+        out[i] = (slot == -1 ? nullptr : &values.slot(slot));
+    });
+}
+
+KVTEMP
+void robinTable<Key, Value>::containsBatch(const Key* batch, size_t n, bool* out)
+{
+    findBatch(batch, n, [out](size_t i, int slot)
+    {
+        out[i] = (slot != -1);
+    });
+}
+
+#ifdef __cpp_impl_coroutine
+KVTEMP
+LookupTask robinTable<Key, Value>::lookupTask(Key key, Value** out)
+{
+    Hash hash = hashKey(key);
+    int home = hash & (hashes.capacity() - 1);
+    prefetchRead(&lengths.slot(home));
+    prefetchRead(&hashes.slot(home));
+    co_await Prefetch(&keys.slot(home));
+
+    // Runs are short, so the rest of the
+    // probe is almost always in those lines.
+    int slot = findSlot(key, hash);
+    *out = (slot == -1 ? nullptr : &values.slot(slot));
+}
+#endif
+
 KVTEMP
 void robinTable<Key, Value>::set(Key key, Value value)
 {
-    int slot = findSlot(key);
+    insertKey(key).value = value;
+}
+
+KVTEMP
+void robinTable<Key, Value>::remove(Key key)
+{
+    int slot = findSlot(key, hashKey(key));
+    if (slot != -1) // Leave it alone if it's empty.
+        shiftBack(slot);
+}
+
+// Transparent lookups go through a std::string_view,
+// so a const char* is only measured once.
+
+KVTEMP
+template<typename K, typename>
+InsertResult<Value> robinTable<Key, Value>::findOrInsert(const K& key)
+{
+    return insertKey(std::string_view(key));
+}
+
+KVTEMP
+template<typename K, typename>
+Value& robinTable<Key, Value>::operator[](const K& key)
+{
+    return insertKey(std::string_view(key)).value;
+}
+
+KVTEMP
+template<typename K, typename>
+Value* robinTable<Key, Value>::get(const K& key)
+{
+    if (count == 0) return nullptr;
+    
+    std::string_view view(key);
+    int slot = findSlot(view, hashKey(view));
     if (slot == -1)
-        add(key, value);
+        return nullptr;
     else
-        values.slot(slot) = value;
+        return &values.slot(slot);
 }
 
 KVTEMP
-void robinTable<Key, Value>::remove(Key key)
+template<typename K, typename>
+void robinTable<Key, Value>::set(const K& key, Value value)
+{
+    insertKey(std::string_view(key)).value = value;
+}
+
+KVTEMP
+template<typename K, typename>
+void robinTable<Key, Value>::remove(const K& key)
 {
-    int slot = findSlot(key);
+    std::string_view view(key);
+    int slot = findSlot(view, hashKey(view));
     if (slot != -1) // Leave it alone if it's empty.
-        states.slot(slot) = TOMBSTONE;
+        shiftBack(slot);
 }
 
 KVTEMP
@@ -253,8 +560,8 @@ void robinTable<Key, Value>::merge(const robinTable<Key, Value>& other)
     size_t capacity = other.hashes.capacity();
     for (size_t i = 0; i < capacity; i++)
     {
-        if (states.slot(i) == VALID)
-            add(other.keys.slot(i), other.values.slot(i));
+        if (other.lengths.front()[i] != 0)
+            add(other.keys.front()[i], other.values.front()[i]);
     }
 }
 
@@ -264,24 +571,49 @@ size_t robinTable<Key, Value>::size()
     return count;
 }
 
+KVTEMP
+ProbeStats robinTable<Key, Value>::probeStats() const
+{
+    ProbeStats stats = {};
+    size_t capacity = hashes.capacity();
+    size_t bitmask = capacity - 1;
+    long total = 0;
+    for (size_t i = 0; i < capacity; i++)
+    {
+        if (lengths.front()[i] == 0)
+            continue;
+
+        size_t origSlot = hashes.front()[i] & bitmask;
+        int length = (int) ((i - origSlot) & bitmask) + 1;
+        total += length;
+        stats.longest = (length > stats.longest ? length : stats.longest);
+    }
+
+    stats.average = (count == 0 ? 0 : (double) total / count);
+    return stats;
+}
+
+#ifdef HASH_TABLE_STATS
+KVTEMP
+size_t robinTable<Key, Value>::probeCount() const
+{
+    return probes;
+}
+#endif
+
 KVTEMP
 void robinTable<Key, Value>::printTable()
 {
-    size_t cap = states.capacity();
+    size_t cap = lengths.capacity();
     for (size_t i = 0; i < cap; i++)
     {
         std::cout << "Slot " << i << ": ";
-        EntryState state = states.slot(i);
-        if (state == EMPTY)
+        if (lengths.slot(i) == 0)
             std::cout << "EMPTY\n";
         else
         {
             std::cout << "(" << keys.slot(i) << ", "
-                << values.slot(i) << ")";
-            if (state == TOMBSTONE)
-                std::cout << " (TOMB)\n";
-            else
-                std::cout << '\n';
+                << values.slot(i) << ")\n";
         }
     }
 }
@@ -0,0 +1 @@
+#include "swissTable.h"
\ No newline at end of file
@@ -0,0 +1,454 @@
+/*  This hash table uses open addressing like linearTable and robinTable, but probes whole groups of 16 slots at a
+*   time, in the style of Abseil's Swiss tables.
+*   Every slot has a 1-byte control word, kept in its own array: EMPTY, DELETED, or the low 7 bits of the hash of the
+*   entry stored there. A lookup loads the control words of a group into an SSE2 register and compares all 16 against
+*   the key's 7-bit fragment in one go, so it only compares keys where the fragments match (nearly always the key
+*   itself). The rest of the hash picks the first group to look at; after that, groups are probed quadratically.
+*   A group with an EMPTY slot ends every search, so a removed entry only leaves a DELETED marker behind if its group
+*   is full (a search might have gone past it); otherwise the slot goes straight back to EMPTY.
+*   Each key is stored next to its value, so a hit costs the control words plus one slot; the control words are what
+*   the search walks over. Without SSE2, groups are matched byte by byte.
+*/
+
+#pragma once
+#include "../../../Dynamic-Array/include/array.h"
+#include "../../General/entryStruct.h"
+#include "../../General/hashFunctions.h"
+#include <cstdint>
+#include <iostream> // For debugging.
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define KVTEMP template<typename Key, typename Value>
+
+// Control words. A full slot holds a 7-bit hash fragment (0-127),
+// so the sign bit alone tells free slots from full ones.
+constexpr int8_t SWISS_EMPTY = -128;
+constexpr int8_t SWISS_DELETED = -2;
+
+// The control words of 16 consecutive slots.
+// Each match returns a mask with bit i set for slot i.
+class SwissGroup
+{
+    private:
+#ifdef __SSE2__
+        __m128i ctrl;
+#else
+        const int8_t* ctrl;
+#endif
+
+    public:
+        static constexpr int width = 16;
+
+        explicit SwissGroup(const int8_t* ctrl);
+
+        uint32_t match(int8_t fragment) const;
+        uint32_t matchEmpty() const;
+        // EMPTY or DELETED.
+        uint32_t matchFree() const;
+};
+
+inline SwissGroup::SwissGroup(const int8_t* ctrl)
+{
+#ifdef __SSE2__
+    this->ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    this->ctrl = ctrl;
+#endif
+}
+
+inline uint32_t SwissGroup::match(int8_t fragment) const
+{
+#ifdef __SSE2__
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(fragment)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < width; i++)
+        mask |= (uint32_t) (ctrl[i] == fragment) << i;
+    return mask;
+#endif
+}
+
+inline uint32_t SwissGroup::matchEmpty() const
+{
+    return match(SWISS_EMPTY);
+}
+
+inline uint32_t SwissGroup::matchFree() const
+{
+#ifdef __SSE2__
+    return _mm_movemask_epi8(ctrl); // The sign bits.
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < width; i++)
+        mask |= (uint32_t) (ctrl[i] < 0) << i;
+    return mask;
+#endif
+}
+
+KVTEMP
+class swissTable
+{
+    private:
+        // Higher than the other tables can manage, since a
+        // search reads a whole group for the price of one slot.
+        // Counts DELETED markers as well as entries.
+        static constexpr double loadFactor = 0.875;
+
+        struct Slot
+        {
+            Key key;
+            Value value;
+        };
+
+        Array<int8_t> ctrl;
+        Array<Slot> slots;
+        size_t count;
+        size_t deleted; // Number of DELETED markers.
+#ifdef HASH_TABLE_STATS
+        size_t probes = 0; // Groups looked at by every search so far.
+#endif
+
+        swissTable(size_t size, Allocator* alloc);
+
+        // Moves every entry into a table of the given capacity,
+        // dropping the DELETED markers.
+        void reorder(size_t capacity);
+        // Makes room for one more entry.
+        void resize();
+        // Slot holding key, or -1.
+        // K is Key, or std::string_view for a transparent lookup.
+        template<typename K>
+        int findSlot(const K& key, Hash hash);
+        // First EMPTY or DELETED slot on the hash's probe sequence.
+        int freeSlot(Hash hash);
+        template<typename K>
+        InsertResult<Value> insertKey(const K& key);
+        void eraseSlot(int index);
+
+    public:
+        swissTable();
+        // Both arrays are allocated from alloc.
+        explicit swissTable(Allocator* alloc);
+        swissTable(const swissTable<Key, Value>& other);
+        ~swissTable() = default;
+        swissTable<Key, Value>& operator=(const swissTable<Key, Value>& other);
+        Value& operator[](Key key);
+
+        // Looks the key up, and adds it with a Value() if missing.
+        InsertResult<Value> findOrInsert(Key key);
+        void add(Key key, Value value);
+        Value* get(Key key);
+        void set(Key key, Value value);
+        void remove(Key key);
+        // Transparent lookups: a table keyed by std::string (or
+        // std::string_view) also takes anything that converts to a
+        // std::string_view, without building a Key to look it up.
+        template<typename K, typename = TransparentKey<Key, K>>
+        InsertResult<Value> findOrInsert(const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        Value& operator[](const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        Value* get(const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        void set(const K& key, Value value);
+        template<typename K, typename = TransparentKey<Key, K>>
+        void remove(const K& key);
+        void merge(const swissTable<Key, Value>& other);
+        size_t size();
+#ifdef HASH_TABLE_STATS
+        size_t probeCount() const;
+#endif
+
+        // For debugging.
+        void printTable();
+};
+
+KVTEMP
+swissTable<Key, Value>::swissTable() :
+    swissTable(SwissGroup::width, defaultAllocator()) {}
+
+KVTEMP
+swissTable<Key, Value>::swissTable(Allocator* alloc) :
+    swissTable(SwissGroup::width, alloc) {}
+
+KVTEMP
+swissTable<Key, Value>::swissTable(const swissTable<Key, Value>& other) :
+    ctrl(other.ctrl), slots(other.slots),
+    count(other.count), deleted(other.deleted) {}
+
+// size is a power of two, and at least one group.
+KVTEMP
+swissTable<Key, Value>::swissTable(size_t size, Allocator* alloc) :
+    ctrl(size, alloc), slots(size, alloc),
+    count(0), deleted(0)
+{
+    ctrl.fillArray(SWISS_EMPTY, true);
+    slots.fillArray(Slot{Key(), Value()}, true);
+}
+
+KVTEMP
+swissTable<Key, Value>& swissTable<Key, Value>::
+operator=(const swissTable<Key, Value>& other)
+{
+    this->ctrl = other.ctrl;
+    this->slots = other.slots;
+    this->count = other.count;
+    this->deleted = other.deleted;
+    return *this;
+}
+
+KVTEMP
+void swissTable<Key, Value>::reorder(size_t capacity)
+{
+    swissTable<Key, Value> newTable(capacity, ctrl.allocator());
+    size_t oldCapacity = ctrl.capacity();
+    for (size_t i = 0; i < oldCapacity; i++)
+    {
+        if (ctrl.slot(i) < 0)
+            continue;
+
+        // Only 7 bits of the hash are kept, so it's
+        // worked out again. Every key is new to the
+        // table, so there's nothing to compare.
+        Hash hash = hashKey(slots.slot(i).key);
+        int index = newTable.freeSlot(hash);
+        newTable.ctrl.slot(index) = (int8_t) (hash & 0x7F);
+        newTable.slots.slot(index) = std::move(slots.slot(i));
+    }
+
+    this->ctrl = std::move(newTable.ctrl);
+    this->slots = std::move(newTable.slots);
+    this->deleted = 0;
+}
+
+KVTEMP
+void swissTable<Key, Value>::resize()
+{
+    size_t capacity = ctrl.capacity();
+    if ((capacity * loadFactor) < count + deleted + 1)
+    {
+        // Mostly DELETED markers: clearing them out is enough.
+        if ((capacity * loadFactor) / 2 < count + 1)
+            capacity *= 2;
+        reorder(capacity);
+    }
+}
+
+KVTEMP
+template<typename K>
+int swissTable<Key, Value>::findSlot(const K& key, Hash hash)
+{
+    size_t groupMask = ctrl.capacity() / SwissGroup::width - 1;
+    size_t group = (hash >> 7) & groupMask;
+    int8_t fragment = (int8_t) (hash & 0x7F);
+
+    // Jumps of 1, 2, 3, ... groups, which visits
+    // every group when there's a power of two of them.
+    for (size_t step = 1; ; step++)
+    {
+#ifdef HASH_TABLE_STATS
+        probes++;
+#endif
+        int first = (int) (group * SwissGroup::width);
+        SwissGroup controls(&ctrl.slot(first));
+        for (uint32_t mask = controls.match(fragment); mask != 0; mask &= mask - 1)
+        {
+            int index = first + __builtin_ctz(mask);
+            if (slots.slot(index).key == key)
+                return index;
+        }
+
+        // Nothing was ever pushed past a group with room in it.
+        if (controls.matchEmpty() != 0)
+            return -1;
+        group = (group + step) & groupMask;
+    }
+}
+
+KVTEMP
+int swissTable<Key, Value>::freeSlot(Hash hash)
+{
+    size_t groupMask = ctrl.capacity() / SwissGroup::width - 1;
+    size_t group = (hash >> 7) & groupMask;
+
+    for (size_t step = 1; ; step++)
+    {
+        int first = (int) (group * SwissGroup::width);
+        uint32_t mask = SwissGroup(&ctrl.slot(first)).matchFree();
+        if (mask != 0)
+            return first + __builtin_ctz(mask);
+        group = (group + step) & groupMask;
+    }
+}
+
+KVTEMP
+template<typename K>
+InsertResult<Value> swissTable<Key, Value>::insertKey(const K& key)
+{
+    Hash hash = hashKey(key);
+    int index = findSlot(key, hash);
+    if (index != -1)
+        return {slots.slot(index).value, false};
+
+    resize();
+    index = freeSlot(hash);
+    if (ctrl.slot(index) == SWISS_DELETED)
+        deleted--;
+
+    ctrl.slot(index) = (int8_t) (hash & 0x7F);
+    slots.slot(index).key = Key(key);
+    slots.slot(index).value = Value();
+    count++;
+    return {slots.slot(index).value, true};
+}
+
+KVTEMP
+void swissTable<Key, Value>::eraseSlot(int index)
+{
+    int first = index & ~(SwissGroup::width - 1);
+    if (SwissGroup(&ctrl.slot(first)).matchEmpty() != 0)
+        ctrl.slot(index) = SWISS_EMPTY;
+    else
+    {
+        ctrl.slot(index) = SWISS_DELETED;
+        deleted++;
+    }
+    count--;
+}
+
+KVTEMP
+InsertResult<Value> swissTable<Key, Value>::findOrInsert(Key key)
+{
+    return insertKey(key);
+}
+
+KVTEMP
+Value& swissTable<Key, Value>::operator[](Key key)
+{
+    return insertKey(key).value;
+}
+
+KVTEMP
+void swissTable<Key, Value>::add(Key key, Value value)
+{
+    insertKey(key).value = value;
+}
+
+KVTEMP
+Value* swissTable<Key, Value>::get(Key key)
+{
+    if (count == 0) return nullptr;
+
+    int slot = findSlot(key, hashKey(key));
+    if (slot == -1)
+        return nullptr;
+    else
+        return &slots.slot(slot).value;
+}
+
+KVTEMP
+void swissTable<Key, Value>::set(Key key, Value value)
+{
+    insertKey(key).value = value;
+}
+
+KVTEMP
+void swissTable<Key, Value>::remove(Key key)
+{
+    int slot = findSlot(key, hashKey(key));
+    if (slot != -1)
+        eraseSlot(slot);
+}
+
+// Transparent lookups go through a std::string_view,
+// so a const char* is only measured once.
+
+KVTEMP
+template<typename K, typename>
+InsertResult<Value> swissTable<Key, Value>::findOrInsert(const K& key)
+{
+    return insertKey(std::string_view(key));
+}
+
+KVTEMP
+template<typename K, typename>
+Value& swissTable<Key, Value>::operator[](const K& key)
+{
+    return insertKey(std::string_view(key)).value;
+}
+
+KVTEMP
+template<typename K, typename>
+Value* swissTable<Key, Value>::get(const K& key)
+{
+    if (count == 0) return nullptr;
+
+    std::string_view view(key);
+    int slot = findSlot(view, hashKey(view));
+    if (slot == -1)
+        return nullptr;
+    else
+        return &slots.slot(slot).value;
+}
+
+KVTEMP
+template<typename K, typename>
+void swissTable<Key, Value>::set(const K& key, Value value)
+{
+    insertKey(std::string_view(key)).value = value;
+}
+
+KVTEMP
+template<typename K, typename>
+void swissTable<Key, Value>::remove(const K& key)
+{
+    std::string_view view(key);
+    int slot = findSlot(view, hashKey(view));
+    if (slot != -1)
+        eraseSlot(slot);
+}
+
+KVTEMP
+void swissTable<Key, Value>::merge(const swissTable<Key, Value>& other)
+{
+    size_t capacity = other.ctrl.capacity();
+    for (size_t i = 0; i < capacity; i++)
+    {
+        if (other.ctrl.front()[i] >= 0)
+            add(other.slots.front()[i].key, other.slots.front()[i].value);
+    }
+}
+
+KVTEMP
+size_t swissTable<Key, Value>::size()
+{
+    return count;
+}
+
+#ifdef HASH_TABLE_STATS
+KVTEMP
+size_t swissTable<Key, Value>::probeCount() const
+{
+    return probes;
+}
+#endif
+
+KVTEMP
+void swissTable<Key, Value>::printTable()
+{
+    size_t cap = ctrl.capacity();
+    for (size_t i = 0; i < cap; i++)
+    {
+        std::cout << "Slot " << i << ": ";
+        int8_t control = ctrl.slot(i);
+        if (control == SWISS_EMPTY)
+            std::cout << "EMPTY\n";
+        else if (control == SWISS_DELETED)
+            std::cout << "DELETED\n";
+        else
+            std::cout << "(" << slots.slot(i).key << ", "
+                << slots.slot(i).value << ")\n";
+    }
+}
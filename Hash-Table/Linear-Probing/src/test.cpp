@@ -1,6 +1,10 @@
 #include "../include/linearTable.h"
+#include "../include/robinTable.h"
+#include "../include/swissTable.h"
 #include <iostream>
 #include <chrono>
+#include <string>
+#include <string_view>
 
 int main()
 {
@@ -38,5 +42,55 @@ int main()
     auto time = duration_cast<milliseconds>(finish - start);
     std::cout << "Time: " << (long double)time.count() / 1000 << '\n';
 
+    // String keys looked up without building a std::string.
+    linearTable<std::string, int> words;
+    robinTable<std::string, int> robinWords;
+    for (const char* word : {"alpha", "beta", "gamma"})
+    {
+        words.add(word, 1);
+        robinWords.add(word, 2);
+    }
+    std::string_view line = "beta gamma";
+    words.remove(line.substr(0, 4));
+    robinWords.set(line.substr(5), 20);
+    std::cout << "Words: " << (words.get("beta") == nullptr) << ' ' << *words.get("gamma")
+        << ' ' << *robinWords.get(line.substr(5)) << '\n';
+
+    // Counting with one probe per word.
+    robinTable<std::string, int> counts;
+    for (std::string_view word : {"to", "be", "or", "not", "to", "be"})
+        counts[word]++;
+    auto result = counts.findOrInsert("question");
+    std::cout << "Counts: to " << counts["to"] << ", not " << counts["not"]
+        << ", question inserted: " << result.inserted << '\n';
+
+    // Same interface, group probing.
+    swissTable<int, int> swiss;
+    for (int i = 0; i < 500; i++)
+        swiss.add(i, i + 1);
+    for (int i = 0; i < 500; i += 2)
+        swiss.remove(i);
+    int found = 0;
+    for (int i = 0; i < 500; i++)
+        found += (swiss.get(i) != nullptr);
+    swissTable<int, int> swissCopy;
+    swissCopy.merge(swiss);
+    std::cout << "Swiss: " << found << " of 500 left, copy has " << swissCopy.size()
+        << ", 499 -> " << *swissCopy.get(499) << '\n';
+
+    // Several lookups at once.
+    robinTable<int, int> squares;
+    for (int i = 0; i < 100; i++)
+        squares.add(i, i * i);
+    int batch[] = {3, 150, 7, 99};
+    int* values[4];
+    bool present[4];
+    squares.getBatch(batch, 4, values);
+    squares.containsBatch(batch, 4, present);
+    std::cout << "Batch:";
+    for (int i = 0; i < 4; i++)
+        std::cout << ' ' << batch[i] << (present[i] ? " -> " + std::to_string(*values[i]) : " missing");
+    std::cout << '\n';
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+// Lookup hit/miss throughput of chainTable with list
+// buckets and flat buckets, at several load factors
+// (entries per bucket).
+
+#include "../include/chainTable.h"
+#include "../../../General/benchTimer.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std::chrono;
+
+template<template<typename> class Bucket>
+static void run(const char* name, int buckets, double load, int rounds)
+{
+    chainTable<int, int, Hasher<int>, Bucket> table;
+    // Never grow on our own, so the load stays where we put it.
+    table.setLoadFactor(1.0);
+    table.rehash(buckets);
+
+    int n = static_cast<int>(buckets * load);
+    for (int i = 0; i < n; i++)
+        table.add(i * 2, i); // Odd keys are misses.
+
+    long sum = 0;
+    auto start = steady_clock::now();
+    for (int round = 0; round < rounds; round++)
+        for (int i = 0; i < n; i++)
+            sum += *table.get(i * 2);
+    long double hits = elapsed(start);
+
+    int misses = 0;
+    start = steady_clock::now();
+    for (int round = 0; round < rounds; round++)
+        for (int i = 0; i < n; i++)
+            misses += (table.get(i * 2 + 1) == nullptr);
+    long double missTime = elapsed(start);
+
+    long double lookups = (long double) n * rounds;
+    std::cout << "  " << name << " hits: " << lookups / hits / 1000 << " M/s, misses: "
+        << lookups / missTime / 1000 << " M/s (checksum " << sum + misses << ")\n";
+}
+
+int main(int argc, char** argv)
+{
+    const int buckets = (argc > 1 ? std::stoi(argv[1]) : 1 << 20);
+    const int rounds = 5;
+
+    for (double load : {0.5, 1.0, 1.5, 2.0})
+    {
+        std::cout << "Load factor " << load << ":\n";
+        run<ListBucket>("ListBucket", buckets, load, rounds);
+        run<FlatBucket>("FlatBucket", buckets, load, rounds);
+    }
+    return 0;
+}
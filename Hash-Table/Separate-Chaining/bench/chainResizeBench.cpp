@@ -0,0 +1,69 @@
+// Time spent in resizes and peak memory while
+// growing a chainTable to n entries.
+
+#include "../include/chainTable.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std::chrono;
+
+// Heap allocator that keeps track of the peak number
+// of bytes requested (not counting malloc's own headers).
+class CountingAllocator : public HeapAllocator
+{
+    public:
+        size_t live = 0;
+        size_t peak = 0;
+
+        void* allocate(size_t size, size_t alignment) override
+        {
+            live += size;
+            peak = (live > peak ? live : peak);
+            return HeapAllocator::allocate(size, alignment);
+        }
+
+        void deallocate(void* ptr, size_t size, size_t alignment) override
+        {
+            live -= size;
+            HeapAllocator::deallocate(ptr, size, alignment);
+        }
+};
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 10000000);
+
+    CountingAllocator counter;
+    {
+        chainTable<int, int> table(&counter);
+
+        // Inserts that take much longer than the rest are
+        // the ones that resized the table.
+        long double resizing = 0;
+        long double longest = 0;
+        int resizes = 0;
+
+        auto start = steady_clock::now();
+        for (int i = 0; i < n; i++)
+        {
+            auto before = steady_clock::now();
+            table.add(i, i);
+            long double ms = (long double) duration_cast<microseconds>(steady_clock::now() - before).count() / 1000;
+            if (ms > 1)
+            {
+                resizing += ms;
+                resizes++;
+                longest = (ms > longest ? ms : longest);
+            }
+        }
+        auto total = duration_cast<milliseconds>(steady_clock::now() - start);
+
+        std::cout << n << " entries: " << total.count() << " ms total, "
+            << resizes << " slow inserts taking " << resizing << " ms (longest "
+            << longest << " ms)\n";
+        std::cout << "Live bytes at the end: " << counter.live / (1024 * 1024) << " MiB\n";
+    }
+    std::cout << "Peak bytes: " << counter.peak / (1024 * 1024) << " MiB\n";
+    return 0;
+}
@@ -0,0 +1,54 @@
+// Lookups when every key collides (a hash function that
+// ignores its input): list buckets against tree buckets.
+
+#include "../include/chainTable.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std::chrono;
+
+// Keeps only the low bits, so keys that are multiples
+// of 2^16 all land in one bucket.
+struct weakHash
+{
+    Hash operator()(int key)
+    {
+        return (Hash) key & 0xFFFF;
+    }
+};
+
+template<template<typename> class Bucket>
+static void run(const char* name, int n)
+{
+    chainTable<int, int, weakHash, Bucket> table;
+
+    auto start = steady_clock::now();
+    for (int i = 0; i < n; i++)
+        table.add(i << 16, i);
+    auto build = duration_cast<microseconds>(steady_clock::now() - start);
+
+    long sum = 0;
+    start = steady_clock::now();
+    for (int i = 0; i < n; i++)
+        sum += *table.get(i << 16);
+    auto lookups = duration_cast<microseconds>(steady_clock::now() - start);
+
+    BucketStats stats = table.bucketStats();
+    std::cout << "  " << name << " build: " << (long double) build.count() / 1000
+        << " ms, lookups: " << (long double) lookups.count() / 1000 << " ms (longest bucket "
+        << stats.longest << ", trees " << stats.trees << ", checksum " << sum << ")\n";
+}
+
+int main(int argc, char** argv)
+{
+    const int largest = (argc > 1 ? std::stoi(argv[1]) : 16000);
+
+    for (int n = 1000; n <= largest; n *= 4)
+    {
+        std::cout << n << " colliding keys:\n";
+        run<ListBucket>("ListBucket", n);
+        run<TreeBucket>("TreeBucket", n);
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Throughput of concurrentTable under mixed workloads
+// (100%, 95% and 50% reads) from 1, 2, 4 and 8 threads,
+// next to a plain chainTable behind a single mutex.
+
+#include "../include/concurrentTable.h"
+#include "../../../General/benchTimer.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+// The old way: one lock around the whole table.
+struct lockedTable
+{
+    std::mutex lock;
+    chainTable<int, int> table;
+
+    void add(int key, int value)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        table.add(key, value);
+    }
+
+    bool get(int key, int& out)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        int* value = table.get(key);
+        if (value == nullptr)
+            return false;
+        out = *value;
+        return true;
+    }
+};
+
+template<typename Table>
+static void run(const char* name, Table& table, int keys, int ops, int readPercent)
+{
+    std::cout << "  " << name << ":";
+    for (int threads : {1, 2, 4, 8})
+    {
+        std::vector<std::thread> workers;
+        std::vector<long> sums(threads * 8);
+        auto start = steady_clock::now();
+        for (int t = 0; t < threads; t++)
+        {
+            workers.emplace_back([&, t]()
+            {
+                uint32_t state = 2463534242u + t; // xorshift
+                long sum = 0;
+                for (int i = 0; i < ops / threads; i++)
+                {
+                    state ^= state << 13;
+                    state ^= state >> 17;
+                    state ^= state << 5;
+                    int key = static_cast<int>(state % keys);
+                    if (static_cast<int>((state >> 8) % 100) < readPercent)
+                    {
+                        int value = 0;
+                        sum += table.get(key, value) ? value : 0;
+                    }
+                    else
+                        table.add(key, i);
+                }
+                sums[t * 8] = sum;
+            });
+        }
+        for (auto& worker : workers)
+            worker.join();
+        long double time = elapsed(start);
+
+        std::cout << "  " << threads << "T " << ops / time / 1000 << " M/s";
+    }
+    std::cout << '\n';
+}
+
+int main(int argc, char** argv)
+{
+    const int keys = (argc > 1 ? std::stoi(argv[1]) : 1 << 20);
+    const int ops = 1 << 22;
+
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << '\n';
+    for (int reads : {100, 95, 50})
+    {
+        std::cout << reads << "% reads (" << keys << " keys):\n";
+
+        concurrentTable<int, int> striped;
+        lockedTable locked;
+        for (int i = 0; i < keys; i++)
+        {
+            striped.add(i, i);
+            locked.add(i, i);
+        }
+
+        run("single mutex", locked, keys, ops, reads);
+        run("concurrentTable", striped, keys, ops, reads);
+    }
+    return 0;
+}
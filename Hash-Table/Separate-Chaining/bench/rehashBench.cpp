@@ -0,0 +1,94 @@
+// Per-insert latency of chainTable with the default
+// (all at once) rehash or with incremental rehashing.
+// One mode per run, so neither one starts right after
+// the other's table has been torn down:
+//   rehashBench [all|incremental] [n]
+
+#include "../include/chainTable.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std::chrono;
+
+// Power-of-two latency histogram, in nanoseconds.
+struct Histogram
+{
+    static constexpr int buckets = 40;
+    long counts[buckets] = {};
+    long total = 0;
+    long long worst = 0;
+
+    void record(long long ns)
+    {
+        int bucket = 0;
+        while ((bucket < buckets - 1) && ((1ll << (bucket + 1)) <= ns))
+            bucket++;
+        counts[bucket]++;
+        total++;
+        worst = (ns > worst ? ns : worst);
+    }
+
+    // Upper bound of the bucket holding the given quantile.
+    long long quantile(double q) const
+    {
+        long target = (long) (q * total);
+        long seen = 0;
+        for (int i = 0; i < buckets; i++)
+        {
+            seen += counts[i];
+            if (seen > target)
+                return (1ll << (i + 1));
+        }
+        return worst;
+    }
+
+    void print(const char* name) const
+    {
+        std::cout << name << ":\n";
+        for (int i = 0; i < buckets; i++)
+        {
+            if (counts[i] != 0)
+                std::cout << "  [" << (1ll << i) << ", " << (1ll << (i + 1)) << ") ns: " << counts[i] << '\n';
+        }
+        std::cout << "  p50 < " << quantile(0.5) << " ns, p99 < " << quantile(0.99)
+            << " ns, p99.9 < " << quantile(0.999) << " ns, max " << worst << " ns\n";
+    }
+};
+
+static void run(const char* name, bool incremental, int n)
+{
+    chainTable<int, int> table;
+    table.setIncremental(incremental);
+    Histogram histogram;
+
+    auto start = steady_clock::now();
+    for (int i = 0; i < n; i++)
+    {
+        auto before = steady_clock::now();
+        table.add(i, i);
+        auto after = steady_clock::now();
+        histogram.record(duration_cast<nanoseconds>(after - before).count());
+    }
+    auto total = duration_cast<microseconds>(steady_clock::now() - start);
+
+    histogram.print(name);
+    std::cout << "  total: " << (long double) total.count() / 1000 << " ms\n";
+}
+
+int main(int argc, char** argv)
+{
+    const std::string mode = (argc > 1 ? argv[1] : "all");
+    const int n = (argc > 2 ? std::stoi(argv[2]) : 1000000);
+
+    if (mode == "all")
+        run("All-at-once rehash", false, n);
+    else if (mode == "incremental")
+        run("Incremental rehash", true, n);
+    else
+    {
+        std::cerr << "Usage: " << argv[0] << " [all|incremental] [n]\n";
+        return 1;
+    }
+    return 0;
+}
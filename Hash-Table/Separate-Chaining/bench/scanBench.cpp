@@ -0,0 +1,64 @@
+// Full-table scan throughput of chainTable: one thread
+// walking every entry, then the bucket array split into
+// ranges scanned by 1, 2, 4 and 8 threads.
+
+#include "../include/chainTable.h"
+#include "../../../General/benchTimer.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+template<template<typename> class Bucket>
+static void run(const char* name, int n, int rounds)
+{
+    chainTable<int, int, Hasher<int>, Bucket> table;
+    for (int i = 0; i < n; i++)
+        table.add(i, i);
+    const auto& view = table;
+
+    std::cout << name << " (" << n << " entries):\n";
+    for (int threads : {1, 2, 4, 8})
+    {
+        std::vector<long> sums(threads * 8); // Padded, one cache line each.
+        auto start = steady_clock::now();
+        for (int round = 0; round < rounds; round++)
+        {
+            std::vector<std::thread> workers;
+            for (int part = 0; part < threads; part++)
+            {
+                workers.emplace_back([&, part]()
+                {
+                    long sum = 0;
+                    for (auto entry : view.range(part, threads))
+                        sum += entry.second;
+                    sums[part * 8] += sum;
+                });
+            }
+            for (auto& worker : workers)
+                worker.join();
+        }
+        long double time = elapsed(start);
+
+        long total = 0;
+        for (int part = 0; part < threads; part++)
+            total += sums[part * 8];
+        long double scanned = (long double) n * rounds;
+        std::cout << "  " << threads << " thread(s): " << scanned / time / 1000
+            << " M entries/s (checksum " << total << ")\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 1 << 21);
+    const int rounds = 10;
+
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << '\n';
+    run<ListBucket>("ListBucket", n, rounds);
+    run<FlatBucket>("FlatBucket", n, rounds);
+    return 0;
+}
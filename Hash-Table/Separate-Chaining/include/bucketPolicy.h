@@ -0,0 +1,977 @@
+/*  Bucket policies for chainTable: how the entries that land in one bucket are stored.
+*   ListBucket keeps them in a LinkedList (one node per entry); FlatBucket keeps them contiguously in a
+*   SmallArray, inline in the bucket array for up to N entries, so scanning a chain is a linear read.
+*   TreeBucket is a ListBucket that turns into a balanced (AVL) tree once it grows past a few entries and
+*   back into a list when it shrinks, so a bucket full of colliding keys is still searched in O(log n).
+*   All of them take an allocator for anything they put on the heap and expose the same small interface:
+*   empty(), size(), treeified(), find(), add(), remove(), redistribute() and iteration over the entries.
+*   Lookups take a key and its hash rather than an entry, and the key only has to compare with the stored one,
+*   so a std::string bucket can be searched with a std::string_view.
+*   Under C++20 each one also has findTask(), the same search as a coroutine that prefetches every node before
+*   reading it (see lookupTask.h).
+*/
+
+#pragma once
+#include "../../../Dynamic-Array/include/smallArray.h"
+#include "../../../Linked-List/Singly-Linked-List/Regular/include/linkedList.h"
+#include "../../General/lookupTask.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename E>
+class ListBucket
+{
+    private:
+        LinkedList<E> list;
+
+    public:
+        using iterator = typename LinkedList<E>::iterator;
+        using const_iterator = typename LinkedList<E>::const_iterator;
+
+        explicit ListBucket(Allocator* alloc);
+
+        bool empty() const;
+        int size() const;
+        bool treeified() const;
+        // Entry with this hash and key, or nullptr.
+        template<typename K>
+        E* find(const K& key, uint32_t hash);
+#ifdef __cpp_impl_coroutine
+        // find() as a lookup coroutine, setting *out.
+        template<typename K>
+        LookupTask findTask(const K& key, uint32_t hash, E** out);
+#endif
+        E& add(E entry);
+        // Returns false if there was nothing to remove.
+        template<typename K>
+        bool remove(const K& key, uint32_t hash);
+        // Hands every entry to the bucket pick(entry) returns and
+        // leaves this one empty. The nodes are relinked, so every
+        // bucket involved must share one allocator.
+        template<typename Pick>
+        void redistribute(Pick pick);
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+};
+
+// Same as the LinkedList inside it.
+template<typename E>
+struct isRelocatable<ListBucket<E>> : std::true_type {};
+
+template<typename E>
+ListBucket<E>::ListBucket(Allocator* alloc) :
+    list(alloc) {}
+
+template<typename E>
+bool ListBucket<E>::empty() const
+{
+    return (list.cbegin() == list.cend());
+}
+
+template<typename E>
+int ListBucket<E>::size() const
+{
+    return list.length();
+}
+
+template<typename E>
+bool ListBucket<E>::treeified() const
+{
+    return false;
+}
+
+template<typename E>
+template<typename K>
+E* ListBucket<E>::find(const K& key, uint32_t hash)
+{
+    for (ListNode<E>* node = list.front(); node != nullptr; node = node->next)
+    {
+        if ((node->object.hash == hash) && (node->object.key == key))
+            return &(node->object);
+    }
+    return nullptr;
+}
+
+#ifdef __cpp_impl_coroutine
+template<typename E>
+template<typename K>
+LookupTask ListBucket<E>::findTask(const K& key, uint32_t hash, E** out)
+{
+    *out = nullptr;
+    co_await Prefetch(this);
+    // Each hop is a dependent load: wait for
+    // a node before reading where it points.
+    for (ListNode<E>* node = list.front(); node != nullptr; node = node->next)
+    {
+        co_await Prefetch(node);
+        if ((node->object.hash == hash) && (node->object.key == key))
+        {
+            *out = &(node->object);
+            co_return;
+        }
+    }
+}
+#endif
+
+template<typename E>
+E& ListBucket<E>::add(E entry)
+{
+    list.append(std::move(entry));
+    return list.back()->object;
+}
+
+template<typename E>
+template<typename K>
+bool ListBucket<E>::remove(const K& key, uint32_t hash)
+{
+    // One walk: keep the node before the match to unlink it.
+    ListNode<E>* previous = nullptr;
+    for (ListNode<E>* node = list.front(); node != nullptr; previous = node, node = node->next)
+    {
+        if ((node->object.hash == hash) && (node->object.key == key))
+        {
+            list.eraseAfter(previous);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename E>
+template<typename Pick>
+void ListBucket<E>::redistribute(Pick pick)
+{
+    while (ListNode<E>* node = list.unlinkFront())
+    {
+        ListBucket<E>& bucket = pick(node->object);
+        bucket.list.linkBack(node);
+    }
+}
+
+template<typename E>
+typename ListBucket<E>::iterator ListBucket<E>::begin()
+{
+    return list.begin();
+}
+
+template<typename E>
+typename ListBucket<E>::iterator ListBucket<E>::end()
+{
+    return list.end();
+}
+
+template<typename E>
+typename ListBucket<E>::const_iterator ListBucket<E>::begin() const
+{
+    return list.begin();
+}
+
+template<typename E>
+typename ListBucket<E>::const_iterator ListBucket<E>::end() const
+{
+    return list.end();
+}
+
+// N entries fit inline; a bucket that overflows
+// spills to the heap like any SmallArray.
+template<typename E, size_t N = 2>
+class FlatBucket
+{
+    private:
+        SmallArray<E, N> entries;
+
+    public:
+        using iterator = typename SmallArray<E, N>::iterator;
+        using const_iterator = typename SmallArray<E, N>::const_iterator;
+
+        explicit FlatBucket(Allocator* alloc);
+
+        bool empty() const;
+        int size() const;
+        bool treeified() const;
+        template<typename K>
+        E* find(const K& key, uint32_t hash);
+#ifdef __cpp_impl_coroutine
+        template<typename K>
+        LookupTask findTask(const K& key, uint32_t hash, E** out);
+#endif
+        E& add(E entry);
+        template<typename K>
+        bool remove(const K& key, uint32_t hash);
+        // Moves every entry into the bucket pick(entry)
+        // returns and leaves this one empty.
+        template<typename Pick>
+        void redistribute(Pick pick);
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+};
+
+template<typename E, size_t N>
+FlatBucket<E, N>::FlatBucket(Allocator* alloc) :
+    entries(alloc) {}
+
+template<typename E, size_t N>
+bool FlatBucket<E, N>::empty() const
+{
+    return (entries.count() == 0);
+}
+
+template<typename E, size_t N>
+int FlatBucket<E, N>::size() const
+{
+    return static_cast<int>(entries.count());
+}
+
+template<typename E, size_t N>
+bool FlatBucket<E, N>::treeified() const
+{
+    return false;
+}
+
+template<typename E, size_t N>
+template<typename K>
+E* FlatBucket<E, N>::find(const K& key, uint32_t hash)
+{
+    E* first = entries.front();
+    E* last = entries.back();
+    for (E* ptr = first; ptr != last; ptr++)
+    {
+        if ((ptr->hash == hash) && (ptr->key == key))
+            return ptr;
+    }
+    return nullptr;
+}
+
+#ifdef __cpp_impl_coroutine
+template<typename E, size_t N>
+template<typename K>
+LookupTask FlatBucket<E, N>::findTask(const K& key, uint32_t hash, E** out)
+{
+    co_await Prefetch(this);
+    E* first = entries.front();
+    // Entries that spilled to the heap need
+    // a second wait; inline ones are here.
+    uintptr_t offset = reinterpret_cast<uintptr_t>(first) - reinterpret_cast<uintptr_t>(this);
+    if ((entries.count() != 0) && (offset >= sizeof(*this)))
+        co_await Prefetch(first);
+    *out = find(key, hash);
+}
+#endif
+
+template<typename E, size_t N>
+E& FlatBucket<E, N>::add(E entry)
+{
+    return entries.emplace(std::move(entry));
+}
+
+template<typename E, size_t N>
+template<typename K>
+bool FlatBucket<E, N>::remove(const K& key, uint32_t hash)
+{
+    E* found = find(key, hash);
+    if (found == nullptr)
+        return false;
+
+    // Order within a bucket doesn't matter, so the
+    // last entry fills the hole.
+    E* last = entries.back() - 1;
+    if (found != last)
+        *found = std::move(*last);
+    entries.pop();
+    return true;
+}
+
+template<typename E, size_t N>
+template<typename Pick>
+void FlatBucket<E, N>::redistribute(Pick pick)
+{
+    E* first = entries.front();
+    E* last = entries.back();
+    for (E* ptr = first; ptr != last; ptr++)
+        pick(*ptr).add(std::move(*ptr));
+    entries.popn(static_cast<int>(entries.count()));
+}
+
+template<typename E, size_t N>
+typename FlatBucket<E, N>::iterator FlatBucket<E, N>::begin()
+{
+    return entries.begin();
+}
+
+template<typename E, size_t N>
+typename FlatBucket<E, N>::iterator FlatBucket<E, N>::end()
+{
+    return entries.end();
+}
+
+template<typename E, size_t N>
+typename FlatBucket<E, N>::const_iterator FlatBucket<E, N>::begin() const
+{
+    return entries.begin();
+}
+
+template<typename E, size_t N>
+typename FlatBucket<E, N>::const_iterator FlatBucket<E, N>::end() const
+{
+    return entries.end();
+}
+
+
+template<typename E>
+struct TreeNode
+{
+    E object;
+    TreeNode<E>* left;
+    TreeNode<E>* right;
+    int height;
+
+    TreeNode(E object);
+};
+
+template<typename E>
+TreeNode<E>::TreeNode(E object) :
+    object(std::move(object)), left(nullptr), right(nullptr), height(1) {}
+
+// Entries are ordered by hash, then by key, so Key needs an operator<
+// that agrees with its operator== (like int, std::string or a pointer).
+template<typename E>
+class TreeBucket
+{
+    public:
+        // Same thresholds as Java's HashMap: the gap between
+        // them stops a bucket from flipping back and forth.
+        static constexpr int treeifyAt = 9;
+        static constexpr int untreeifyAt = 6;
+
+    private:
+        // Holds the entries while the bucket is short;
+        // also where the allocator lives.
+        LinkedList<E> list;
+        TreeNode<E>* root; // nullptr unless treeified.
+        int count;
+
+        static bool before(const E& first, const E& second);
+        // Where a (hash, key) lookup falls relative to entry:
+        // negative before it, positive after, 0 on it.
+        template<typename K>
+        static int order(const K& key, uint32_t hash, const E& entry);
+        static int height(TreeNode<E>* node);
+        static void update(TreeNode<E>* node);
+        static TreeNode<E>* rotateLeft(TreeNode<E>* node);
+        static TreeNode<E>* rotateRight(TreeNode<E>* node);
+        static TreeNode<E>* rebalance(TreeNode<E>* node);
+        static TreeNode<E>* insert(TreeNode<E>* node, TreeNode<E>* fresh);
+        // Unlinks the node holding key and stores it in removed.
+        template<typename K>
+        static TreeNode<E>* unlink(TreeNode<E>* node, const K& key, uint32_t hash, TreeNode<E>** removed);
+        static TreeNode<E>* unlinkMin(TreeNode<E>* node, TreeNode<E>** removed);
+
+        TreeNode<E>* newNode(E object);
+        void freeNode(TreeNode<E>* node);
+        TreeNode<E>* copyTree(const TreeNode<E>* node);
+        void freeTree(TreeNode<E>* node);
+        void treeify();
+        void untreeify();
+        // Takes in a node from another bucket's list.
+        void adopt(ListNode<E>* node);
+
+    public:
+        explicit TreeBucket(Allocator* alloc);
+        TreeBucket(const TreeBucket& other);
+        TreeBucket& operator=(const TreeBucket& other);
+        TreeBucket(TreeBucket&& other);
+        TreeBucket& operator=(TreeBucket&& other);
+        ~TreeBucket();
+
+        bool empty() const;
+        int size() const;
+        bool treeified() const;
+        template<typename K>
+        E* find(const K& key, uint32_t hash);
+#ifdef __cpp_impl_coroutine
+        template<typename K>
+        LookupTask findTask(const K& key, uint32_t hash, E** out);
+#endif
+        E& add(E entry);
+        template<typename K>
+        bool remove(const K& key, uint32_t hash);
+        template<typename Pick>
+        void redistribute(Pick pick);
+
+        // Walks the list, or the tree in order.
+        class iterator
+        {
+            private:
+                ListNode<E>* node;
+                // Nodes still to visit in the tree (an AVL tree
+                // of 2^32 nodes is at most 46 levels deep).
+                TreeNode<E>* path[48];
+                int depth;
+
+                void pushLeft(TreeNode<E>* node);
+
+            public:
+                iterator(ListNode<E>* node = nullptr);
+                iterator(TreeNode<E>* root);
+
+                E& operator*() const;
+                iterator& operator++();
+                bool operator==(const iterator& other) const;
+                bool operator!=(const iterator& other) const;
+        };
+
+        class const_iterator
+        {
+            private:
+                iterator it;
+
+            public:
+                const_iterator(iterator it = iterator());
+
+                const E& operator*() const;
+                const_iterator& operator++();
+                bool operator==(const const_iterator& other) const;
+                bool operator!=(const const_iterator& other) const;
+        };
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+};
+
+// Tree nodes don't point back at the bucket either.
+template<typename E>
+struct isRelocatable<TreeBucket<E>> : std::true_type {};
+
+template<typename E>
+TreeBucket<E>::TreeBucket(Allocator* alloc) :
+    list(alloc), root(nullptr), count(0) {}
+
+template<typename E>
+TreeBucket<E>::TreeBucket(const TreeBucket& other) :
+    list(other.list), root(nullptr), count(other.count)
+{
+    root = copyTree(other.root);
+}
+
+template<typename E>
+TreeBucket<E>& TreeBucket<E>::operator=(const TreeBucket& other)
+{
+    if (this != &other)
+    {
+        freeTree(root);
+        list = other.list;
+        root = copyTree(other.root);
+        count = other.count;
+    }
+
+    return *this;
+}
+
+template<typename E>
+TreeBucket<E>::TreeBucket(TreeBucket&& other) :
+    list(std::move(other.list)), root(other.root), count(other.count)
+{
+    other.root = nullptr;
+    other.count = 0;
+}
+
+template<typename E>
+TreeBucket<E>& TreeBucket<E>::operator=(TreeBucket&& other)
+{
+    if (this != &other)
+    {
+        freeTree(root);
+        list = std::move(other.list);
+        root = other.root;
+        count = other.count;
+
+        other.root = nullptr;
+        other.count = 0;
+    }
+
+    return *this;
+}
+
+template<typename E>
+TreeBucket<E>::~TreeBucket()
+{
+    freeTree(root);
+}
+
+template<typename E>
+bool TreeBucket<E>::before(const E& first, const E& second)
+{
+    if (first.hash != second.hash)
+        return (first.hash < second.hash);
+    return (first.key < second.key);
+}
+
+template<typename E>
+template<typename K>
+int TreeBucket<E>::order(const K& key, uint32_t hash, const E& entry)
+{
+    if (hash != entry.hash)
+        return (hash < entry.hash ? -1 : 1);
+    if (key < entry.key)
+        return -1;
+    return (entry.key < key ? 1 : 0);
+}
+
+template<typename E>
+int TreeBucket<E>::height(TreeNode<E>* node)
+{
+    return (node == nullptr ? 0 : node->height);
+}
+
+template<typename E>
+void TreeBucket<E>::update(TreeNode<E>* node)
+{
+    int left = height(node->left);
+    int right = height(node->right);
+    node->height = 1 + (left > right ? left : right);
+}
+
+template<typename E>
+TreeNode<E>* TreeBucket<E>::rotateLeft(TreeNode<E>* node)
+{
+    TreeNode<E>* right = node->right;
+    node->right = right->left;
+    right->left = node;
+    update(node);
+    update(right);
+    return right;
+}
+
+template<typename E>
+TreeNode<E>* TreeBucket<E>::rotateRight(TreeNode<E>* node)
+{
+    TreeNode<E>* left = node->left;
+    node->left = left->right;
+    left->right = node;
+    update(node);
+    update(left);
+    return left;
+}
+
+template<typename E>
+TreeNode<E>* TreeBucket<E>::rebalance(TreeNode<E>* node)
+{
+    update(node);
+    int balance = height(node->left) - height(node->right);
+
+    if (balance > 1)
+    {
+        if (height(node->left->left) < height(node->left->right))
+            node->left = rotateLeft(node->left);
+        return rotateRight(node);
+    }
+    if (balance < -1)
+    {
+        if (height(node->right->right) < height(node->right->left))
+            node->right = rotateRight(node->right);
+        return rotateLeft(node);
+    }
+    return node;
+}
+
+template<typename E>
+TreeNode<E>* TreeBucket<E>::insert(TreeNode<E>* node, TreeNode<E>* fresh)
+{
+    if (node == nullptr)
+        return fresh;
+
+    if (before(fresh->object, node->object))
+        node->left = insert(node->left, fresh);
+    else
+        node->right = insert(node->right, fresh);
+    return rebalance(node);
+}
+
+template<typename E>
+TreeNode<E>* TreeBucket<E>::unlinkMin(TreeNode<E>* node, TreeNode<E>** removed)
+{
+    if (node->left == nullptr)
+    {
+        *removed = node;
+        return node->right;
+    }
+
+    node->left = unlinkMin(node->left, removed);
+    return rebalance(node);
+}
+
+template<typename E>
+template<typename K>
+TreeNode<E>* TreeBucket<E>::unlink(TreeNode<E>* node, const K& key, uint32_t hash, TreeNode<E>** removed)
+{
+    if (node == nullptr)
+        return nullptr;
+
+    int side = order(key, hash, node->object);
+    if (side < 0)
+        node->left = unlink(node->left, key, hash, removed);
+    else if (side > 0)
+        node->right = unlink(node->right, key, hash, removed);
+    else
+    {
+        *removed = node;
+        if ((node->left == nullptr) || (node->right == nullptr))
+            return (node->left != nullptr ? node->left : node->right);
+
+        // Two children: the smallest node on the right takes its place.
+        TreeNode<E>* successor = nullptr;
+        TreeNode<E>* right = unlinkMin(node->right, &successor);
+        successor->left = node->left;
+        successor->right = right;
+        return rebalance(successor);
+    }
+
+    return rebalance(node);
+}
+
+template<typename E>
+TreeNode<E>* TreeBucket<E>::newNode(E object)
+{
+    Allocator* alloc = list.allocator();
+    void* memory = alloc->allocate(sizeof(TreeNode<E>), alignof(TreeNode<E>));
+    return new (memory) TreeNode<E>(std::move(object));
+}
+
+template<typename E>
+void TreeBucket<E>::freeNode(TreeNode<E>* node)
+{
+    node->~TreeNode<E>();
+    list.allocator()->deallocate(node, sizeof(TreeNode<E>), alignof(TreeNode<E>));
+}
+
+template<typename E>
+TreeNode<E>* TreeBucket<E>::copyTree(const TreeNode<E>* node)
+{
+    if (node == nullptr)
+        return nullptr;
+
+    TreeNode<E>* copy = newNode(node->object);
+    copy->left = copyTree(node->left);
+    copy->right = copyTree(node->right);
+    copy->height = node->height;
+    return copy;
+}
+
+template<typename E>
+void TreeBucket<E>::freeTree(TreeNode<E>* node)
+{
+    if (node == nullptr)
+        return;
+
+    freeTree(node->left);
+    freeTree(node->right);
+    freeNode(node);
+}
+
+template<typename E>
+void TreeBucket<E>::treeify()
+{
+    while (list.front() != nullptr)
+        root = insert(root, newNode(list.erase(0)));
+}
+
+template<typename E>
+void TreeBucket<E>::untreeify()
+{
+    for (iterator it = iterator(root); it != end(); ++it)
+        list.append(std::move(*it));
+    freeTree(root);
+    root = nullptr;
+}
+
+template<typename E>
+void TreeBucket<E>::adopt(ListNode<E>* node)
+{
+    if (root != nullptr)
+    {
+        // Both lists share an allocator.
+        root = insert(root, newNode(std::move(node->object)));
+        node->~ListNode<E>();
+        list.allocator()->deallocate(node, sizeof(ListNode<E>), alignof(ListNode<E>));
+    }
+    else
+        list.linkBack(node);
+
+    if ((++count >= treeifyAt) && (root == nullptr))
+        treeify();
+}
+
+template<typename E>
+bool TreeBucket<E>::empty() const
+{
+    return (count == 0);
+}
+
+template<typename E>
+int TreeBucket<E>::size() const
+{
+    return count;
+}
+
+template<typename E>
+bool TreeBucket<E>::treeified() const
+{
+    return (root != nullptr);
+}
+
+template<typename E>
+template<typename K>
+E* TreeBucket<E>::find(const K& key, uint32_t hash)
+{
+    if (root == nullptr)
+    {
+        for (ListNode<E>* node = list.front(); node != nullptr; node = node->next)
+        {
+            if ((node->object.hash == hash) && (node->object.key == key))
+                return &(node->object);
+        }
+        return nullptr;
+    }
+
+    TreeNode<E>* node = root;
+    while (node != nullptr)
+    {
+        int side = order(key, hash, node->object);
+        if (side < 0)
+            node = node->left;
+        else if (side > 0)
+            node = node->right;
+        else
+            return &(node->object);
+    }
+    return nullptr;
+}
+
+#ifdef __cpp_impl_coroutine
+template<typename E>
+template<typename K>
+LookupTask TreeBucket<E>::findTask(const K& key, uint32_t hash, E** out)
+{
+    *out = nullptr;
+    co_await Prefetch(this);
+    if (root == nullptr)
+    {
+        for (ListNode<E>* node = list.front(); node != nullptr; node = node->next)
+        {
+            co_await Prefetch(node);
+            if ((node->object.hash == hash) && (node->object.key == key))
+            {
+                *out = &(node->object);
+                co_return;
+            }
+        }
+        co_return;
+    }
+
+    TreeNode<E>* node = root;
+    while (node != nullptr)
+    {
+        co_await Prefetch(node);
+        int side = order(key, hash, node->object);
+        if (side < 0)
+            node = node->left;
+        else if (side > 0)
+            node = node->right;
+        else
+        {
+            *out = &(node->object);
+            co_return;
+        }
+    }
+}
+#endif
+
+template<typename E>
+E& TreeBucket<E>::add(E entry)
+{
+    count++;
+    if ((root == nullptr) && (count < treeifyAt))
+    {
+        list.append(std::move(entry));
+        return list.back()->object;
+    }
+
+    if (root == nullptr)
+        treeify();
+    TreeNode<E>* node = newNode(std::move(entry));
+    root = insert(root, node);
+    return node->object;
+}
+
+template<typename E>
+template<typename K>
+bool TreeBucket<E>::remove(const K& key, uint32_t hash)
+{
+    if (root == nullptr)
+    {
+        ListNode<E>* previous = nullptr;
+        for (ListNode<E>* node = list.front(); node != nullptr; previous = node, node = node->next)
+        {
+            if ((node->object.hash == hash) && (node->object.key == key))
+            {
+                list.eraseAfter(previous);
+                count--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    TreeNode<E>* removed = nullptr;
+    root = unlink(root, key, hash, &removed);
+    if (removed == nullptr)
+        return false;
+
+    freeNode(removed);
+    if (--count <= untreeifyAt)
+        untreeify();
+    return true;
+}
+
+template<typename E>
+template<typename Pick>
+void TreeBucket<E>::redistribute(Pick pick)
+{
+    if (root == nullptr)
+    {
+        while (ListNode<E>* node = list.unlinkFront())
+            pick(node->object).adopt(node);
+    }
+    else
+    {
+        for (iterator it = iterator(root); it != end(); ++it)
+            pick(*it).add(std::move(*it));
+        freeTree(root);
+        root = nullptr;
+    }
+    count = 0;
+}
+
+// Iterator.
+
+template<typename E>
+TreeBucket<E>::iterator::iterator(ListNode<E>* node) :
+    node(node), depth(0) {}
+
+template<typename E>
+TreeBucket<E>::iterator::iterator(TreeNode<E>* root) :
+    node(nullptr), depth(0)
+{
+    pushLeft(root);
+}
+
+template<typename E>
+void TreeBucket<E>::iterator::pushLeft(TreeNode<E>* node)
+{
+    for (; node != nullptr; node = node->left)
+        path[depth++] = node;
+}
+
+template<typename E>
+E& TreeBucket<E>::iterator::operator*() const
+{
+    if (depth > 0)
+        return path[depth - 1]->object;
+    return node->object;
+}
+
+template<typename E>
+typename TreeBucket<E>::iterator& TreeBucket<E>::iterator::operator++()
+{
+    if (depth > 0)
+    {
+        TreeNode<E>* current = path[--depth];
+        pushLeft(current->right);
+    }
+    else
+        node = node->next;
+    return *this;
+}
+
+template<typename E>
+bool TreeBucket<E>::iterator::operator==(const iterator& other) const
+{
+    const void* current = (depth > 0 ? (const void*) path[depth - 1] : (const void*) node);
+    const void* otherCurrent = (other.depth > 0 ? (const void*) other.path[other.depth - 1] : (const void*) other.node);
+    return (current == otherCurrent);
+}
+
+template<typename E>
+bool TreeBucket<E>::iterator::operator!=(const iterator& other) const
+{
+    return !(*this == other);
+}
+
+template<typename E>
+typename TreeBucket<E>::iterator TreeBucket<E>::begin()
+{
+    if (root != nullptr)
+        return iterator(root);
+    return iterator(list.front());
+}
+
+template<typename E>
+typename TreeBucket<E>::iterator TreeBucket<E>::end()
+{
+    return iterator((ListNode<E>*) nullptr);
+}
+
+// Constant iterator.
+
+template<typename E>
+TreeBucket<E>::const_iterator::const_iterator(iterator it) :
+    it(it) {}
+
+template<typename E>
+const E& TreeBucket<E>::const_iterator::operator*() const
+{
+    return *it;
+}
+
+template<typename E>
+typename TreeBucket<E>::const_iterator& TreeBucket<E>::const_iterator::operator++()
+{
+    ++it;
+    return *this;
+}
+
+template<typename E>
+bool TreeBucket<E>::const_iterator::operator==(const const_iterator& other) const
+{
+    return (it == other.it);
+}
+
+template<typename E>
+bool TreeBucket<E>::const_iterator::operator!=(const const_iterator& other) const
+{
+    return (it != other.it);
+}
+
+template<typename E>
+typename TreeBucket<E>::const_iterator TreeBucket<E>::begin() const
+{
+    // Only reads through it.
+    return const_iterator(const_cast<TreeBucket<E>*>(this)->begin());
+}
+
+template<typename E>
+typename TreeBucket<E>::const_iterator TreeBucket<E>::end() const
+{
+    return const_iterator(iterator((ListNode<E>*) nullptr));
+}
@@ -1,33 +1,60 @@
 /*  This hash table implementation uses a basic separate chaining approach for hash collisions.
-*   Each bucket contains a (non-intrusive/regular) linked list (implemented in this project),
-*   which is traversed to search for a key match upon a collision occurring.
+*   By default each bucket contains a (non-intrusive/regular) linked list (implemented in this project),
+*   which is traversed to search for a key match upon a collision occurring. The Bucket parameter swaps
+*   that for another policy from bucketPolicy.h, such as FlatBucket (entries stored contiguously).
+*   With incremental rehashing on, growing the table doesn't move every entry at once: the old bucket
+*   array is kept next to the new one and a few buckets are moved over on each insertion or removal, with
+*   lookups and removals checking both arrays until the move is done. Lookups never move anything, as a
+*   FlatBucket moves its entries by value and would leave earlier get() pointers dangling.
 */
 
 #pragma once
 #include "../../../Dynamic-Array/include/array.h"
 #include "../../General/entryStruct.h"
 #include "../../General/hashFunctions.h"
-#include "../../../Linked-List/Singly-Linked-List/Regular/include/linkedList.h"
+#include "bucketPolicy.h"
 #include <cstdint>
+#include <initializer_list>
 #include <iostream> // FOR DEBUGGING.
 
-#define KVHTEMP             template<typename Key, typename Value, typename HashFunc>
-#define KVHTEMP_DEFAULT     template<typename Key, typename Value, typename HashFunc = Hasher<Key>>
+#define KVHTEMP             template<typename Key, typename Value, typename HashFunc, \
+                                template<typename> class Bucket>
+#define KVHTEMP_DEFAULT     template<typename Key, typename Value, typename HashFunc = Hasher<Key>, \
+                                template<typename> class Bucket = ListBucket>
 #define EKV                 Entry<Key, Value>
-#define EKVList             LinkedList<EKV>
+#define EKVBucket           Bucket<EKV>
 
 template<typename Key>
 struct Hasher
 {
-    Hash operator()(Key key)
+    Hash operator()(const Key& key)
     {
         return hashKey(key);
     }
 
-    Hash operator()(Key key, size_t size)
+    Hash operator()(const Key& key, size_t size)
     {
         return hashKey(key, size);
     }
+
+    // Transparent lookups (string keys only).
+    template<typename K, typename = TransparentKey<Key, K>>
+    Hash operator()(const K& key)
+    {
+        return hashString(key);
+    }
+};
+
+struct BucketStats
+{
+    int buckets; // Slots in the bucket array(s).
+    int used; // Non-empty ones.
+    int longest;
+    double average; // Entries per non-empty bucket.
+    int trees; // Buckets stored as trees (TreeBucket).
+    // lengths[i] is the number of buckets holding i entries;
+    // the last one also counts every longer bucket.
+    int lengths[9];
 };
 
 KVHTEMP_DEFAULT
@@ -36,9 +63,10 @@ class chainTable
     private:
         HashFunc getHash;
         // Keeping the same load factor for 
-        // both implementations.
-        static constexpr double loadFactor = 0.8;
-        Array<EKVList> entries;
+        // both implementations (by default).
+        // Counts non-empty buckets, not entries.
+        double loadFactor;
+        Array<EKVBucket> entries;
         // Number of buckets (slots in the array) we've used up.
         int bucketCount;
         // Number of key-value pairs we have in the table.
@@ -48,30 +76,88 @@ class chainTable
         // Will mark how far into the array we have entries to copy.
         int maxIndex;
 
-        chainTable(int size);
+        // Incremental rehashing.
+        bool incremental;
+        // Buckets still waiting to be moved into entries.
+        Array<EKVBucket> oldEntries;
+        int oldMaxIndex;
+        // Next bucket of oldEntries to move (-1 if not rehashing).
+        int rehashIndex;
+        // Non-empty buckets moved per insertion or removal.
+        static constexpr int rehashStep = 4;
+
+        chainTable(int size, Allocator* alloc);
 
-        void reorder();
+        void reorder(size_t capacity);
         void resize();
+        void startRehash(size_t capacity);
+        // Moves up to buckets non-empty buckets (and skips
+        // at most ten times as many empty ones).
+        void stepRehash(int buckets);
+        void finishRehash();
+        // Moves every entry of bucket into entries.
+        void migrate(EKVBucket& bucket);
+        // The entry holding key (or nullptr), and the bucket it's in.
+        // K is Key, or std::string_view for a transparent lookup.
+        template<typename K>
+        EKV* findEntry(const K& key, Hash hash, EKVBucket** bucket);
         // Adds a key with no value.
         EKV& emptyAdd(Key key);
-        EKV* getEntry(Key key);
+        template<typename K>
+        EKV* getEntry(const K& key);
+        template<typename K>
+        void removeEntry(const K& key);
     
     public:
         chainTable();
-        chainTable(const chainTable<Key, Value, HashFunc>& other);
+        // The bucket array and every chain node come from alloc.
+        explicit chainTable(Allocator* alloc);
+        chainTable(const chainTable<Key, Value, HashFunc, Bucket>& other);
         ~chainTable() = default;
-        chainTable<Key, Value, HashFunc>& operator=(const chainTable<Key, Value, HashFunc>& other);
+        chainTable<Key, Value, HashFunc, Bucket>& operator=(const chainTable<Key, Value, HashFunc, Bucket>& other);
         Value& operator[](Key key);
 
         void add(Key key, Value value);
         Value* get(Key key);
         void set(Key key, Value value);
         void remove(Key key);
-        void merge(const chainTable<Key, Value, HashFunc>& other);
+#ifdef __cpp_impl_coroutine
+        // One get() as a coroutine for interleave() (C++20 only):
+        // sets *out to the value, or nullptr if key isn't there.
+        LookupTask lookupTask(Key key, Value** out);
+#endif
+        void merge(const chainTable<Key, Value, HashFunc, Bucket>& other);
+
+        // Transparent lookups: a table keyed by std::string (or
+        // std::string_view) also takes anything that converts to a
+        // std::string_view, without building a Key unless it has to
+        // insert one. HashFunc has to accept a std::string_view.
+        template<typename K, typename = TransparentKey<Key, K>>
+        Value& operator[](const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        Value* get(const K& key);
+        template<typename K, typename = TransparentKey<Key, K>>
+        void set(const K& key, Value value);
+        template<typename K, typename = TransparentKey<Key, K>>
+        void remove(const K& key);
+
+        // Off by default. Turning it off finishes
+        // any rehash in progress.
+        void setIncremental(bool incremental);
+        bool rehashing() const;
+        // Grow once the fraction of non-empty buckets passes this.
+        void setLoadFactor(double loadFactor);
+        // Moves everything into an array of at least buckets
+        // buckets (rounded up to a power of two).
+        void rehash(size_t buckets);
 
         int bucketSize();
         int entrySize();
 
+        // Shows how evenly the hash spreads the keys.
+        BucketStats bucketStats() const;
+        int bucketLength(int n) const; // Entries in bucket n.
+
         struct Pair
         {
             Key first;
@@ -81,82 +167,94 @@ class chainTable
             Pair(EKV entry);
         };
 
-        // Iterates across buckets.
-        class iterator
+        // What the iterators yield: references into the stored
+        // entry, so nothing is copied (the key can't be changed).
+        struct Reference
         {
-            private:
-                Pair* ptr;
-            
-            public:
-                iterator(Pair* ptr);
-                iterator(const iterator& other);
-                iterator& operator=(const iterator& other);
+            const Key& first;
+            Value& second;
+        };
 
-                Pair& operator*() const;
-                iterator& operator++();
-                iterator operator++(int);
-                iterator& operator--();
-                iterator operator--(int);
-                bool operator==(const iterator& other);
-                bool operator!=(const iterator& other);
+        struct ConstReference
+        {
+            const Key& first;
+            const Value& second;
         };
 
-        // Iterates across elements of a single bucket.
-        class local_iterator
+        // Iterates across buckets (both arrays while rehashing),
+        // and through each bucket in place.
+        class iterator
         {
             private:
-                Pair* ptr;
-                int bucketIndex;
-            
+                using BucketIter = typename EKVBucket::iterator;
+
+                chainTable<Key, Value, HashFunc, Bucket>* table;
+                size_t slot;
+                size_t last; // Slot where this range stops.
+                BucketIter it;
+
+                // Moves to the first entry at or after slot.
+                void settle();
+
             public:
-                local_iterator(Pair* ptr);
-                local_iterator(const local_iterator& other);
-                local_iterator& operator=(const local_iterator& other);
+                iterator(chainTable<Key, Value, HashFunc, Bucket>* table, size_t slot, size_t last);
 
-                Pair& operator*() const;
-                local_iterator& operator++();
-                local_iterator operator++(int);
-                local_iterator& operator--();
-                local_iterator operator--(int);
-                bool operator==(const local_iterator& other);
-                bool operator!=(const local_iterator& other);
+                Reference operator*() const;
+                iterator& operator++();
+                iterator operator++(int);
+                bool operator==(const iterator& other) const;
+                bool operator!=(const iterator& other) const;
         };
 
         class const_iterator
         {
             private:
-                const Pair* ptr;
-            
+                using BucketIter = typename EKVBucket::const_iterator;
+
+                const chainTable<Key, Value, HashFunc, Bucket>* table;
+                size_t slot;
+                size_t last;
+                BucketIter it;
+
+                void settle();
+
             public:
-                const_iterator(const Pair* ptr);
-                const_iterator(const const_iterator& other);
-                const_iterator& operator=(const const_iterator& other);
+                const_iterator(const chainTable<Key, Value, HashFunc, Bucket>* table, size_t slot, size_t last);
 
-                const Pair& operator*() const;
+                ConstReference operator*() const;
                 const_iterator& operator++();
                 const_iterator operator++(int);
-                const_iterator& operator--();
-                const_iterator operator--(int);
                 bool operator==(const const_iterator& other) const;
                 bool operator!=(const const_iterator& other) const;
         };
 
+        // Iterates across elements of a single bucket.
+        class local_iterator
+        {
+            private:
+                typename EKVBucket::iterator it;
+
+            public:
+                local_iterator(typename EKVBucket::iterator it);
+
+                Reference operator*() const;
+                local_iterator& operator++();
+                local_iterator operator++(int);
+                bool operator==(const local_iterator& other) const;
+                bool operator!=(const local_iterator& other) const;
+        };
+
         class const_local_iterator
         {
             private:
-                const Pair* ptr;
-                const int bucketIndex;
+                typename EKVBucket::const_iterator it;
 
             public:
-                const_local_iterator(const Pair* ptr);
-                const_local_iterator(const const_local_iterator& other);
-                const_local_iterator& operator=(const const_local_iterator& other);
+                const_local_iterator(typename EKVBucket::const_iterator it);
 
-                const Pair& operator*() const;
+                ConstReference operator*() const;
                 const_local_iterator& operator++();
                 const_local_iterator operator++(int);
-                const_local_iterator& operator--();
-                const_local_iterator operator--(int);
                 bool operator==(const const_local_iterator& other) const;
                 bool operator!=(const const_local_iterator& other) const;
         };
@@ -178,45 +276,74 @@ class chainTable
         const_local_iterator cbegin(int n) const;
         const_local_iterator cend(int n) const;
 
+        // Splitting the table for parallel scans: part p of
+        // parts covers its own run of buckets, and together
+        // the parts cover every entry exactly once.
+        template<typename Iter>
+        struct Range
+        {
+            Iter first;
+            Iter last;
+
+            Iter begin() const { return first; }
+            Iter end() const { return last; }
+        };
+
+        // Bucket slots across both arrays (what range() splits).
+        size_t slotCount() const;
+        Range<iterator> range(int part, int parts);
+        Range<const_iterator> range(int part, int parts) const;
+
         // For debugging.
         void printTable();
 };
 
 KVHTEMP
-chainTable<Key, Value, HashFunc>::chainTable() :
-    getHash(HashFunc()), bucketCount(0), entryCount(0),
-    maxIndex(-1) {}
+chainTable<Key, Value, HashFunc, Bucket>::chainTable() :
+    chainTable(defaultAllocator()) {}
 
 KVHTEMP
-chainTable<Key, Value, HashFunc>::chainTable(const chainTable<Key, Value, HashFunc>& other)
-{
-    this->entries = Array<EKVList>(static_cast<int>(other.entries.capacity()));
-    size_t size = this->entries.capacity();
-    for (size_t i = 0; i < size; i++)
-        entries.push(copy(other.entries[i]));
-    this->bucketCount = other.bucketCount;
-    this->entryCount = other.entryCount;
-}
+chainTable<Key, Value, HashFunc, Bucket>::chainTable(Allocator* alloc) :
+    getHash(HashFunc()), loadFactor(0.8), entries(alloc), bucketCount(0),
+    entryCount(0), maxIndex(-1), incremental(false),
+    oldEntries(alloc), oldMaxIndex(-1), rehashIndex(-1) {}
 
+// Array copies every bucket (with its allocator).
+// A rehash in progress carries over as well.
 KVHTEMP
-chainTable<Key, Value, HashFunc>::chainTable(int size) :
-    getHash(HashFunc()), entries(size), bucketCount(0),
-    entryCount(0), maxIndex(-1) {}
+chainTable<Key, Value, HashFunc, Bucket>::chainTable(const chainTable<Key, Value, HashFunc, Bucket>& other) :
+    getHash(other.getHash), loadFactor(other.loadFactor), entries(other.entries), bucketCount(other.bucketCount),
+    entryCount(other.entryCount), maxIndex(other.maxIndex), incremental(other.incremental),
+    oldEntries(other.oldEntries), oldMaxIndex(other.oldMaxIndex), rehashIndex(other.rehashIndex) {}
 
 KVHTEMP
-chainTable<Key, Value, HashFunc>& chainTable<Key, Value, HashFunc>
-::operator=(const chainTable<Key, Value, HashFunc>& other)
+chainTable<Key, Value, HashFunc, Bucket>::chainTable(int size, Allocator* alloc) :
+    getHash(HashFunc()), loadFactor(0.8), entries(size, alloc), bucketCount(0),
+    entryCount(0), maxIndex(-1), incremental(false),
+    oldEntries(alloc), oldMaxIndex(-1), rehashIndex(-1)
 {
-    this->entries = Array<EKVList>(static_cast<int>(other.entries.capacity()));
-    size_t size = this->entries.capacity();
-    for (size_t i = 0; i < size; i++)
-        entries.push(copy(other.entries[i]));
+    entries.fillArray(EKVBucket(alloc), true); // Every bucket starts out empty.
+}
+
+KVHTEMP
+chainTable<Key, Value, HashFunc, Bucket>& chainTable<Key, Value, HashFunc, Bucket>
+::operator=(const chainTable<Key, Value, HashFunc, Bucket>& other)
+{
+    this->getHash = other.getHash;
+    this->loadFactor = other.loadFactor;
+    this->entries = other.entries;
     this->bucketCount = other.bucketCount;
     this->entryCount = other.entryCount;
+    this->maxIndex = other.maxIndex;
+    this->incremental = other.incremental;
+    this->oldEntries = other.oldEntries;
+    this->oldMaxIndex = other.oldMaxIndex;
+    this->rehashIndex = other.rehashIndex;
+    return *this;
 }
 
 KVHTEMP
-EKV& chainTable<Key, Value, HashFunc>::emptyAdd(Key key)
+EKV& chainTable<Key, Value, HashFunc, Bucket>::emptyAdd(Key key)
 {
     // This method is only called internally,
     // so we can skip checks for the key existing
@@ -229,20 +356,20 @@ EKV& chainTable<Key, Value, HashFunc>::emptyAdd(Key key)
     int index = static_cast<int>(hash & bitmask);
     maxIndex = (index > maxIndex) ? index : maxIndex;
 
-    EKVList& list = entries.slot(index);
-    if (list.front() == nullptr) // Empty list.
+    EKVBucket& bucket = entries.slot(index);
+    if (bucket.empty())
         bucketCount++; // We're filling a new "bucket".
 
-    EKV entry = EKV(key, hash);
-    
-    list.append(entry);
     entryCount++;
-    return list.at(list.length() - 1)->object;
+    return bucket.add(EKV(key, hash));
 }
 
 KVHTEMP
-Value& chainTable<Key, Value, HashFunc>::operator[](Key key)
+Value& chainTable<Key, Value, HashFunc, Bucket>::operator[](Key key)
 {
+    if (rehashing())
+        stepRehash(rehashStep);
+
     EKV* entry = getEntry(key);
     if (entry == nullptr)
         return emptyAdd(key).value;
@@ -251,70 +378,197 @@ Value& chainTable<Key, Value, HashFunc>::operator[](Key key)
 }
 
 KVHTEMP
-void chainTable<Key, Value, HashFunc>::reorder()
+void chainTable<Key, Value, HashFunc, Bucket>::reorder(size_t capacity)
 {
-    // Easier to just construct a new table.
-    size_t capacity = entries.capacity(); // Cover entire array.
-    chainTable<Key, Value, HashFunc> newTable(static_cast<int>(capacity));
-    for (size_t i = 0; i < this->maxIndex + 1; i++)
+    // The old buckets only have to live until their
+    // nodes are relinked into the new ones.
+    Allocator* alloc = entries.allocator();
+    Array<EKVBucket> oldBuckets = std::move(entries);
+    int oldMax = maxIndex;
+
+    entries = Array<EKVBucket>(static_cast<int>(capacity), alloc);
+    entries.fillArray(EKVBucket(alloc), true);
+    maxIndex = -1; // Re-ordering may lead to a new max index.
+
+    for (int i = 0; i <= oldMax; i++)
     {
-        EKVList& list = entries.slot(static_cast<int>(i));
-        
-        // Handles empty lists as well.
-        for (auto* ptr = list.front(); ptr != nullptr; ptr = ptr->next)
-        {
-            EKV entry = ptr->object;
-            newTable.add(entry.key, entry.value);
-        }
+        EKVBucket& bucket = oldBuckets.slot(i);
+        if (!bucket.empty())
+            migrate(bucket);
     }
-
-    this->entries = newTable.entries;
-    this->bucketCount = newTable.bucketCount;
-    this->maxIndex = newTable.maxIndex; // Re-ordering may have led to a new max index.
-    // entryCount doesn't change.
+    // entryCount doesn't change; migrate() keeps bucketCount right.
 }
 
 // Array will automatically resize if needed, but
 // we may need to trigger resizing earlier if
 // we reach the load factor.
 KVHTEMP
-void chainTable<Key, Value, HashFunc>::resize()
+void chainTable<Key, Value, HashFunc, Bucket>::resize()
 {
     if ((entries.capacity() * loadFactor) < bucketCount + 1)
     {
+        // Only one rehash at a time.
+        if (rehashing())
+            finishRehash();
+
         if (entryCount == 0)
+        {
             entries.grow();
+            entries.fillArray(EKVBucket(entries.allocator()), true);
+        }
+        else if (incremental)
+            startRehash(entries.capacity() * 2);
         else
+            reorder(entries.capacity() * 2);
+    }
+}
+
+KVHTEMP
+void chainTable<Key, Value, HashFunc, Bucket>::startRehash(size_t capacity)
+{
+    Allocator* alloc = entries.allocator();
+    oldEntries = std::move(entries);
+    oldMaxIndex = maxIndex;
+    rehashIndex = 0;
+
+    entries = Array<EKVBucket>(static_cast<int>(capacity), alloc);
+    entries.fillArray(EKVBucket(alloc), true);
+    maxIndex = -1;
+}
+
+KVHTEMP
+void chainTable<Key, Value, HashFunc, Bucket>::stepRehash(int buckets)
+{
+    int emptyVisits = buckets * 10;
+    while ((buckets > 0) && (rehashIndex <= oldMaxIndex))
+    {
+        EKVBucket& bucket = oldEntries.slot(rehashIndex++);
+        if (bucket.empty())
         {
-            entries.increaseCapacity();
-            reorder();
+            if (--emptyVisits == 0)
+                break;
+            continue;
         }
+
+        migrate(bucket);
+        buckets--;
+    }
+
+    if (rehashIndex > oldMaxIndex) // Done; drop the old array.
+    {
+        oldEntries = Array<EKVBucket>(entries.allocator());
+        oldMaxIndex = -1;
+        rehashIndex = -1;
     }
 }
 
 KVHTEMP
-EKV* chainTable<Key, Value, HashFunc>::getEntry(Key key)
+void chainTable<Key, Value, HashFunc, Bucket>::finishRehash()
+{
+    while (rehashing())
+        stepRehash(oldMaxIndex + 1);
+}
+
+KVHTEMP
+void chainTable<Key, Value, HashFunc, Bucket>::migrate(EKVBucket& bucket)
+{
+    bucketCount--; // The old bucket empties out.
+
+    // Entries keep their hash, so nothing is rehashed, and every
+    // bucket shares the table's allocator, so list nodes
+    // move over as they are: no allocation and no copies.
+    uint32_t bitmask = (uint32_t)(entries.capacity() - 1);
+    bucket.redistribute([this, bitmask](const EKV& entry) -> EKVBucket& {
+        int index = static_cast<int>(entry.hash & bitmask);
+        maxIndex = (index > maxIndex) ? index : maxIndex;
+
+        EKVBucket& target = entries.slot(index);
+        if (target.empty())
+            bucketCount++;
+        return target;
+    });
+}
+
+KVHTEMP
+template<typename K>
+EKV* chainTable<Key, Value, HashFunc, Bucket>::findEntry(const K& key, Hash hash, EKVBucket** bucket)
+{
+    uint32_t bitmask = (uint32_t)(entries.capacity() - 1);
+    *bucket = &(entries.slot(static_cast<int>(hash & bitmask)));
+    EKV* entry = (*bucket)->find(key, hash);
+    if (entry != nullptr)
+        return entry;
+
+    if (rehashing())
+    {
+        // Buckets below rehashIndex have already moved.
+        bitmask = (uint32_t)(oldEntries.capacity() - 1);
+        int index = static_cast<int>(hash & bitmask);
+        if (index >= rehashIndex)
+        {
+            *bucket = &(oldEntries.slot(index));
+            return (*bucket)->find(key, hash);
+        }
+    }
+
+    return nullptr;
+}
+
+KVHTEMP
+template<typename K>
+EKV* chainTable<Key, Value, HashFunc, Bucket>::getEntry(const K& key)
 {
     if (entryCount == 0)
         return nullptr;
     
     uint32_t hash = getHash(key);
-    uint32_t bitmask = (uint32_t)(entries.capacity() - 1);
-    int index = static_cast<int>(hash & bitmask);
-    EKVList& list = entries.slot(index);
+    EKVBucket* bucket = nullptr;
+    return findEntry(key, hash, &bucket);
+}
+
+KVHTEMP
+template<typename K>
+void chainTable<Key, Value, HashFunc, Bucket>::removeEntry(const K& key)
+{
+    if (entryCount == 0)
+        return;
+
+    if (rehashing())
+        stepRehash(rehashStep);
     
-    EKV temp(key, hash); // temp.value uninitialized.
+    // The bucket searches and unlinks in one walk,
+    // so there's no findEntry() beforehand.
+    uint32_t hash = getHash(key);
+    uint32_t bitmask = (uint32_t)(entries.capacity() - 1);
+    EKVBucket* bucket = &(entries.slot(static_cast<int>(hash & bitmask)));
+    bool removed = bucket->remove(key, hash);
 
-    auto* nodePtr = list.get(temp);
-    if (nodePtr == nullptr)
-        return nullptr;
+    if (!removed && rehashing())
+    {
+        // Buckets below rehashIndex have already moved.
+        bitmask = (uint32_t)(oldEntries.capacity() - 1);
+        int index = static_cast<int>(hash & bitmask);
+        if (index >= rehashIndex)
+        {
+            bucket = &(oldEntries.slot(index));
+            removed = bucket->remove(key, hash);
+        }
+    }
 
-    return &(nodePtr->object);
+    if (!removed)
+        return;
+
+    entryCount--;
+    if (bucket->empty()) // Bucket only had one entry.
+        bucketCount--;
 }
 
 KVHTEMP
-void chainTable<Key, Value, HashFunc>::add(Key key, Value value)
+void chainTable<Key, Value, HashFunc, Bucket>::add(Key key, Value value)
 {
+    if (rehashing())
+        stepRehash(rehashStep);
+
     EKV* temp = getEntry(key);
     if (temp != nullptr) // Key already exists.
     {
@@ -329,18 +583,16 @@ void chainTable<Key, Value, HashFunc>::add(Key key, Value value)
     int index = static_cast<int>(hash & bitmask);
     maxIndex = (index > maxIndex) ? index : maxIndex;
 
-    EKVList& list = entries.slot(index);
-    if (list.front() == nullptr) // Empty list.
+    EKVBucket& bucket = entries.slot(index);
+    if (bucket.empty())
         bucketCount++; // We're filling a new "bucket".
 
-    EKV entry(key, value, hash);
-    
-    list.append(entry);
+    bucket.add(EKV(key, value, hash));
     entryCount++;
 }
 
 KVHTEMP
-Value* chainTable<Key, Value, HashFunc>::get(Key key)
+Value* chainTable<Key, Value, HashFunc, Bucket>::get(Key key)
 {
     EKV* entry = getEntry(key);
     if (entry == nullptr)
@@ -350,7 +602,7 @@ Value* chainTable<Key, Value, HashFunc>::get(Key key)
 }
 
 KVHTEMP
-void chainTable<Key, Value, HashFunc>::set(Key key, Value value)
+void chainTable<Key, Value, HashFunc, Bucket>::set(Key key, Value value)
 {
     EKV* entry = getEntry(key);
 
@@ -361,75 +613,542 @@ void chainTable<Key, Value, HashFunc>::set(Key key, Value value)
 }
 
 KVHTEMP
-void chainTable<Key, Value, HashFunc>::remove(Key key)
+void chainTable<Key, Value, HashFunc, Bucket>::remove(Key key)
 {
+    removeEntry(key);
+}
+
+#ifdef __cpp_impl_coroutine
+KVHTEMP
+LookupTask chainTable<Key, Value, HashFunc, Bucket>::lookupTask(Key key, Value** out)
+{
+    *out = nullptr;
     if (entryCount == 0)
-        return;
-    
+        co_return;
+
+    // Same search as findEntry(), one
+    // bucket (and node) at a time.
     uint32_t hash = getHash(key);
     uint32_t bitmask = (uint32_t)(entries.capacity() - 1);
-    int index = static_cast<int>(hash & bitmask);
-    EKVList& list = entries.slot(index);
-    EKV temp = EKV(key, hash);
-    if (!list.has(temp))
-        return;
-    
-    list.remove(temp);
-    entryCount--;
-    if (list.front() == nullptr) // List only had one node.
-        bucketCount--;
+    EKV* entry = nullptr;
+    co_await entries.slot(static_cast<int>(hash & bitmask)).findTask(key, hash, &entry);
+
+    if ((entry == nullptr) && rehashing())
+    {
+        bitmask = (uint32_t)(oldEntries.capacity() - 1);
+        int index = static_cast<int>(hash & bitmask);
+        if (index >= rehashIndex)
+            co_await oldEntries.slot(index).findTask(key, hash, &entry);
+    }
+
+    if (entry != nullptr)
+        *out = &(entry->value);
 }
+#endif
+
+// Transparent lookups go through a std::string_view,
+// so a const char* is only measured once.
 
 KVHTEMP
-void chainTable<Key, Value, HashFunc>::merge(const chainTable<Key, Value, HashFunc>& other)
+template<typename K, typename>
+Value& chainTable<Key, Value, HashFunc, Bucket>::operator[](const K& key)
 {
-    size_t capacity = other.entries.capacity();
-    for (size_t i = 0; i < capacity; i++)
-    {
-        EKVList& list = other.entries.slot(static_cast<int>(i));
-        if (list.front() == nullptr)
-            continue;
+    if (rehashing())
+        stepRehash(rehashStep);
+
+    std::string_view view(key);
+    EKV* entry = getEntry(view);
+    if (entry == nullptr)
+        return emptyAdd(Key(view)).value;
+
+    return entry->value;
+}
 
-        for (auto* ptr = list.front(); ptr != nullptr; ptr = ptr->next)
+KVHTEMP
+template<typename K, typename>
+Value* chainTable<Key, Value, HashFunc, Bucket>::get(const K& key)
+{
+    EKV* entry = getEntry(std::string_view(key));
+    if (entry == nullptr)
+        return nullptr;
+    else
+        return &(entry->value);
+}
+
+KVHTEMP
+template<typename K, typename>
+void chainTable<Key, Value, HashFunc, Bucket>::set(const K& key, Value value)
+{
+    std::string_view view(key);
+    EKV* entry = getEntry(view);
+
+    if (entry == nullptr) // Key does not exist.
+        add(Key(view), value);
+    else
+        entry->value = value;
+}
+
+KVHTEMP
+template<typename K, typename>
+void chainTable<Key, Value, HashFunc, Bucket>::remove(const K& key)
+{
+    removeEntry(std::string_view(key));
+}
+
+KVHTEMP
+void chainTable<Key, Value, HashFunc, Bucket>::merge(const chainTable<Key, Value, HashFunc, Bucket>& other)
+{
+    // Both of other's arrays, in case it's mid-rehash (buckets
+    // that have already moved are just empty).
+    for (const Array<EKVBucket>* array : {&other.entries, &other.oldEntries})
+    {
+        for (size_t i = 0; i < array->count(); i++)
         {
-            EKV entry = ptr->object;
-            add(entry.key, entry.value);
+            for (const EKV& entry : array->front()[i])
+                add(entry.key, entry.value);
         }
     }
 }
 
 KVHTEMP
-int chainTable<Key, Value, HashFunc>::bucketSize()
+void chainTable<Key, Value, HashFunc, Bucket>::setIncremental(bool incremental)
+{
+    this->incremental = incremental;
+    if (!incremental)
+        finishRehash();
+}
+
+KVHTEMP
+bool chainTable<Key, Value, HashFunc, Bucket>::rehashing() const
+{
+    return (rehashIndex >= 0);
+}
+
+KVHTEMP
+void chainTable<Key, Value, HashFunc, Bucket>::setLoadFactor(double loadFactor)
+{
+    this->loadFactor = loadFactor;
+}
+
+KVHTEMP
+void chainTable<Key, Value, HashFunc, Bucket>::rehash(size_t buckets)
+{
+    size_t capacity = 8;
+    while (capacity < buckets)
+        capacity *= 2;
+
+    finishRehash();
+    if (capacity == entries.capacity())
+        return;
+
+    if (entryCount == 0)
+    {
+        entries = Array<EKVBucket>(static_cast<int>(capacity), entries.allocator());
+        entries.fillArray(EKVBucket(entries.allocator()), true);
+        bucketCount = 0;
+        maxIndex = -1;
+    }
+    else
+        reorder(capacity);
+}
+
+KVHTEMP
+int chainTable<Key, Value, HashFunc, Bucket>::bucketSize()
 {
     return bucketCount;
 }
 
 KVHTEMP
-int chainTable<Key, Value, HashFunc>::entrySize()
+int chainTable<Key, Value, HashFunc, Bucket>::entrySize()
 {
     return entryCount;
 }
 
+KVHTEMP
+BucketStats chainTable<Key, Value, HashFunc, Bucket>::bucketStats() const
+{
+    BucketStats stats = {};
+    const int last = static_cast<int>(sizeof(stats.lengths) / sizeof(stats.lengths[0])) - 1;
+
+    // Buckets that have already moved out of oldEntries
+    // count as empty slots there.
+    for (const Array<EKVBucket>* array : {&entries, &oldEntries})
+    {
+        for (size_t i = 0; i < array->count(); i++)
+        {
+            const EKVBucket& bucket = array->front()[i];
+            int length = bucket.size();
+
+            stats.buckets++;
+            stats.lengths[length < last ? length : last]++;
+            if (length == 0)
+                continue;
+
+            stats.used++;
+            stats.longest = (length > stats.longest ? length : stats.longest);
+            stats.trees += bucket.treeified();
+        }
+    }
+
+    stats.average = (stats.used == 0 ? 0 : (double) entryCount / stats.used);
+    return stats;
+}
+
+KVHTEMP
+int chainTable<Key, Value, HashFunc, Bucket>::bucketLength(int n) const
+{
+    if ((n < 0) || ((size_t) n >= entries.count()))
+        throw std::out_of_range("Invalid bucket index.");
+
+    return entries.front()[n].size();
+}
+
 // Pair struct.
 KVHTEMP
-chainTable<Key, Value, HashFunc>::Pair::Pair(EKV entry) :
+chainTable<Key, Value, HashFunc, Bucket>::Pair::Pair(EKV entry) :
     first(entry.key), second(entry.value) {}
 
+KVHTEMP
+size_t chainTable<Key, Value, HashFunc, Bucket>::slotCount() const
+{
+    return entries.count() + oldEntries.count();
+}
+
+// Slot i is entries[i], then oldEntries[i - entries.count()].
+// Old buckets that already moved are empty, so they're skipped.
+#define chainSlot(table, i) \
+    ((i) < (table)->entries.count() ? (table)->entries.front()[i] \
+        : (table)->oldEntries.front()[(i) - (table)->entries.count()])
+
+// Iterator.
+
+#define chainIter chainTable<Key, Value, HashFunc, Bucket>::iterator
+
+KVHTEMP
+chainIter::iterator(chainTable<Key, Value, HashFunc, Bucket>* table, size_t slot, size_t last) :
+    table(table), slot(slot), last(last), it() // Only read once settle() finds a bucket.
+{
+    settle();
+}
+
+KVHTEMP
+void chainIter::settle()
+{
+    for (; slot < last; slot++)
+    {
+        EKVBucket& bucket = chainSlot(table, slot);
+        if (!bucket.empty())
+        {
+            it = bucket.begin();
+            return;
+        }
+    }
+}
+
+KVHTEMP
+typename chainTable<Key, Value, HashFunc, Bucket>::Reference chainIter::operator*() const
+{
+    EKV& entry = *it;
+    return Reference{entry.key, entry.value};
+}
+
+KVHTEMP
+typename chainIter& chainIter::operator++()
+{
+    ++it;
+    if (it == chainSlot(table, slot).end())
+    {
+        slot++;
+        settle();
+    }
+    return *this;
+}
+
+KVHTEMP
+typename chainIter chainIter::operator++(int)
+{
+    iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+KVHTEMP
+bool chainIter::operator==(const iterator& other) const
+{
+    // Bucket iterators are only compared inside a bucket.
+    if (this->slot != other.slot)
+        return false;
+    return ((this->slot >= this->last) || (this->it == other.it));
+}
+
+KVHTEMP
+bool chainIter::operator!=(const iterator& other) const
+{
+    return !(*this == other);
+}
+
+KVHTEMP
+typename chainIter chainTable<Key, Value, HashFunc, Bucket>::begin()
+{
+    return iterator(this, 0, slotCount());
+}
+
+KVHTEMP
+typename chainIter chainTable<Key, Value, HashFunc, Bucket>::end()
+{
+    return iterator(this, slotCount(), slotCount());
+}
+
+// Constant iterator.
+
+#define constChainIter chainTable<Key, Value, HashFunc, Bucket>::const_iterator
+
+KVHTEMP
+constChainIter::const_iterator(const chainTable<Key, Value, HashFunc, Bucket>* table, size_t slot, size_t last) :
+    table(table), slot(slot), last(last), it() // Only read once settle() finds a bucket.
+{
+    settle();
+}
+
+KVHTEMP
+void constChainIter::settle()
+{
+    for (; slot < last; slot++)
+    {
+        const EKVBucket& bucket = chainSlot(table, slot);
+        if (!bucket.empty())
+        {
+            it = bucket.begin();
+            return;
+        }
+    }
+}
+
+KVHTEMP
+typename chainTable<Key, Value, HashFunc, Bucket>::ConstReference constChainIter::operator*() const
+{
+    const EKV& entry = *it;
+    return ConstReference{entry.key, entry.value};
+}
+
+KVHTEMP
+typename constChainIter& constChainIter::operator++()
+{
+    ++it;
+    if (it == chainSlot(table, slot).end())
+    {
+        slot++;
+        settle();
+    }
+    return *this;
+}
+
+KVHTEMP
+typename constChainIter constChainIter::operator++(int)
+{
+    const_iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+KVHTEMP
+bool constChainIter::operator==(const const_iterator& other) const
+{
+    if (this->slot != other.slot)
+        return false;
+    return ((this->slot >= this->last) || (this->it == other.it));
+}
+
+KVHTEMP
+bool constChainIter::operator!=(const const_iterator& other) const
+{
+    return !(*this == other);
+}
+
+KVHTEMP
+typename constChainIter chainTable<Key, Value, HashFunc, Bucket>::begin() const
+{
+    return const_iterator(this, 0, slotCount());
+}
+
+KVHTEMP
+typename constChainIter chainTable<Key, Value, HashFunc, Bucket>::end() const
+{
+    return const_iterator(this, slotCount(), slotCount());
+}
+
+KVHTEMP
+typename constChainIter chainTable<Key, Value, HashFunc, Bucket>::cbegin() const
+{
+    return begin();
+}
+
+KVHTEMP
+typename constChainIter chainTable<Key, Value, HashFunc, Bucket>::cend() const
+{
+    return end();
+}
+
+// Local iterator.
+
+#define chainLocalIter chainTable<Key, Value, HashFunc, Bucket>::local_iterator
+
+KVHTEMP
+chainLocalIter::local_iterator(typename EKVBucket::iterator it) :
+    it(it) {}
+
+KVHTEMP
+typename chainTable<Key, Value, HashFunc, Bucket>::Reference chainLocalIter::operator*() const
+{
+    EKV& entry = *it;
+    return Reference{entry.key, entry.value};
+}
+
+KVHTEMP
+typename chainLocalIter& chainLocalIter::operator++()
+{
+    ++it;
+    return *this;
+}
+
+KVHTEMP
+typename chainLocalIter chainLocalIter::operator++(int)
+{
+    local_iterator temp = *this;
+    ++it;
+    return temp;
+}
+
+KVHTEMP
+bool chainLocalIter::operator==(const local_iterator& other) const
+{
+    return (this->it == other.it);
+}
+
+KVHTEMP
+bool chainLocalIter::operator!=(const local_iterator& other) const
+{
+    return !(this->it == other.it);
+}
+
+KVHTEMP
+typename chainLocalIter chainTable<Key, Value, HashFunc, Bucket>::begin(int n)
+{
+    return local_iterator(entries.front()[n].begin());
+}
+
+KVHTEMP
+typename chainLocalIter chainTable<Key, Value, HashFunc, Bucket>::end(int n)
+{
+    return local_iterator(entries.front()[n].end());
+}
+
+// Constant local iterator.
+
+#define constChainLocalIter chainTable<Key, Value, HashFunc, Bucket>::const_local_iterator
+
+KVHTEMP
+constChainLocalIter::const_local_iterator(typename EKVBucket::const_iterator it) :
+    it(it) {}
+
+KVHTEMP
+typename chainTable<Key, Value, HashFunc, Bucket>::ConstReference constChainLocalIter::operator*() const
+{
+    const EKV& entry = *it;
+    return ConstReference{entry.key, entry.value};
+}
+
+KVHTEMP
+typename constChainLocalIter& constChainLocalIter::operator++()
+{
+    ++it;
+    return *this;
+}
+
+KVHTEMP
+typename constChainLocalIter constChainLocalIter::operator++(int)
+{
+    const_local_iterator temp = *this;
+    ++it;
+    return temp;
+}
+
+KVHTEMP
+bool constChainLocalIter::operator==(const const_local_iterator& other) const
+{
+    return (this->it == other.it);
+}
+
+KVHTEMP
+bool constChainLocalIter::operator!=(const const_local_iterator& other) const
+{
+    return !(this->it == other.it);
+}
+
+KVHTEMP
+typename constChainLocalIter chainTable<Key, Value, HashFunc, Bucket>::begin(int n) const
+{
+    return const_local_iterator(entries.front()[n].begin());
+}
+
+KVHTEMP
+typename constChainLocalIter chainTable<Key, Value, HashFunc, Bucket>::end(int n) const
+{
+    return const_local_iterator(entries.front()[n].end());
+}
+
+KVHTEMP
+typename constChainLocalIter chainTable<Key, Value, HashFunc, Bucket>::cbegin(int n) const
+{
+    return begin(n);
+}
+
+KVHTEMP
+typename constChainLocalIter chainTable<Key, Value, HashFunc, Bucket>::cend(int n) const
+{
+    return end(n);
+}
+
+// Ranges.
+
+KVHTEMP
+typename chainTable<Key, Value, HashFunc, Bucket>::template Range<typename chainIter>
+chainTable<Key, Value, HashFunc, Bucket>::range(int part, int parts)
+{
+    size_t slots = slotCount();
+    size_t first = slots * part / parts;
+    size_t last = slots * (part + 1) / parts;
+    return Range<iterator>{iterator(this, first, last), iterator(this, last, last)};
+}
+
+KVHTEMP
+typename chainTable<Key, Value, HashFunc, Bucket>::template Range<typename constChainIter>
+chainTable<Key, Value, HashFunc, Bucket>::range(int part, int parts) const
+{
+    size_t slots = slotCount();
+    size_t first = slots * part / parts;
+    size_t last = slots * (part + 1) / parts;
+    return Range<const_iterator>{const_iterator(this, first, last), const_iterator(this, last, last)};
+}
+
 // For debugging.
 KVHTEMP
-void chainTable<Key, Value, HashFunc>::printTable()
+void chainTable<Key, Value, HashFunc, Bucket>::printTable()
 {
     for (size_t i = 0; i < entries.capacity(); i++)
     {
-        EKVList& list = entries.slot(static_cast<int>(i));
-        if (list.front() == nullptr)
+        EKVBucket& bucket = entries.slot(static_cast<int>(i));
+        if (bucket.empty())
             std::cout << "Slot " << i << ": EMPTY\n";
         else
         {
             std::cout << "Slot " << i << ": ";
-            for (auto& pair : list)
+            for (auto& pair : bucket)
                 std::cout << "(" << pair.key << ", " << pair.value << ")->";
             std::cout << '\n';
         }
     }
+
+    if (rehashing())
+        std::cout << "Rehashing: " << (oldMaxIndex - rehashIndex + 1) << " old slots left.\n";
 }
\ No newline at end of file
@@ -0,0 +1 @@
+#include "concurrentTable.h"
\ No newline at end of file
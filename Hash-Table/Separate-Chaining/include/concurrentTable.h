@@ -0,0 +1,213 @@
+/*  A chainTable that many threads can use at once.
+*   Keys are split by hash across a fixed number of stripes, each one a separate chainTable (its own range of
+*   buckets) guarded by its own reader/writer lock. Lookups take the lock shared, so readers never wait on each
+*   other; writes take it exclusively, and only block operations that land in the same stripe.
+*   Growing happens inside a stripe, under its exclusive lock, so a resize never has to stop the whole table and
+*   nobody can see a half-moved bucket array. The stripe tables don't rehash incrementally, so a stripe's lookups
+*   only ever search one bucket array.
+*   Values are copied out rather than handed back by pointer, as a pointer would outlive the lock protecting it.
+*   The allocator must be safe to call from several threads (the default heap one is).
+*/
+
+#pragma once
+#include "chainTable.h"
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+
+KVHTEMP_DEFAULT
+class concurrentTable
+{
+    private:
+        // One cache line each, so locking one stripe
+        // doesn't bounce its neighbors' lines around.
+        struct alignas(64) Stripe
+        {
+            std::shared_mutex lock;
+            chainTable<Key, Value, HashFunc, Bucket> table;
+
+            explicit Stripe(Allocator* alloc);
+        };
+
+        // Stateless in practice; mutable so const
+        // lookups can call it.
+        mutable HashFunc getHash;
+        Allocator* alloc;
+        Stripe* stripes;
+        int stripeCount; // Always a power of two.
+        int stripeBits;
+
+        Stripe& stripeFor(const Key& key) const;
+
+    public:
+        static constexpr int defaultStripes = 64;
+
+        concurrentTable();
+        // Rounded up to a power of two.
+        explicit concurrentTable(int count, Allocator* alloc = defaultAllocator());
+        // Locks can't be copied, and nothing should
+        // be copying a table other threads are using.
+        concurrentTable(const concurrentTable<Key, Value, HashFunc, Bucket>& other) = delete;
+        concurrentTable<Key, Value, HashFunc, Bucket>& operator=(const concurrentTable<Key, Value, HashFunc, Bucket>& other) = delete;
+        ~concurrentTable();
+
+        void add(Key key, Value value);
+        // Copies the value into out if the key is there.
+        bool get(Key key, Value& out) const;
+        bool contains(Key key) const;
+        // Returns false if the key wasn't there.
+        bool remove(Key key);
+        // Runs func on the stored value under the stripe's
+        // write lock (for read-modify-write updates).
+        template<typename Func>
+        bool update(Key key, Func func);
+
+        // Applied to every stripe.
+        void setLoadFactor(double loadFactor);
+        // Grows each stripe (one at a time) so the table
+        // has at least buckets buckets in total.
+        void rehash(size_t buckets);
+
+        int stripeSize() const;
+        // Locks each stripe in turn, so it's only exact
+        // if nobody is writing.
+        int entrySize() const;
+};
+
+KVHTEMP
+concurrentTable<Key, Value, HashFunc, Bucket>::Stripe::Stripe(Allocator* alloc) :
+    table(alloc) {}
+
+KVHTEMP
+concurrentTable<Key, Value, HashFunc, Bucket>::concurrentTable() :
+    concurrentTable(defaultStripes) {}
+
+KVHTEMP
+concurrentTable<Key, Value, HashFunc, Bucket>::concurrentTable(int count, Allocator* alloc) :
+    getHash(HashFunc()), alloc(alloc), stripeCount(1), stripeBits(0)
+{
+    while (stripeCount < count)
+    {
+        stripeCount <<= 1;
+        stripeBits++;
+    }
+
+    stripes = static_cast<Stripe*>(alloc->allocate(stripeCount * sizeof(Stripe), alignof(Stripe)));
+    for (int i = 0; i < stripeCount; i++)
+        new (&stripes[i]) Stripe(alloc);
+}
+
+KVHTEMP
+concurrentTable<Key, Value, HashFunc, Bucket>::~concurrentTable()
+{
+    for (int i = 0; i < stripeCount; i++)
+        stripes[i].~Stripe();
+    alloc->deallocate(stripes, stripeCount * sizeof(Stripe), alignof(Stripe));
+}
+
+KVHTEMP
+typename concurrentTable<Key, Value, HashFunc, Bucket>::Stripe&
+concurrentTable<Key, Value, HashFunc, Bucket>::stripeFor(const Key& key) const
+{
+    if (stripeBits == 0)
+        return stripes[0];
+
+    // The stripe tables index buckets with the low bits of the
+    // hash, so pick the stripe from a scrambled copy's high bits.
+    uint32_t mixed = getHash(key) * 0x9E3779B9u;
+    return stripes[mixed >> (32 - stripeBits)];
+}
+
+KVHTEMP
+void concurrentTable<Key, Value, HashFunc, Bucket>::add(Key key, Value value)
+{
+    Stripe& stripe = stripeFor(key);
+    std::unique_lock<std::shared_mutex> guard(stripe.lock);
+    stripe.table.add(key, value);
+}
+
+KVHTEMP
+bool concurrentTable<Key, Value, HashFunc, Bucket>::get(Key key, Value& out) const
+{
+    Stripe& stripe = stripeFor(key);
+    std::shared_lock<std::shared_mutex> guard(stripe.lock);
+    // get() only reads, so a shared lock is enough.
+    Value* value = stripe.table.get(key);
+    if (value == nullptr)
+        return false;
+
+    out = *value;
+    return true;
+}
+
+KVHTEMP
+bool concurrentTable<Key, Value, HashFunc, Bucket>::contains(Key key) const
+{
+    Stripe& stripe = stripeFor(key);
+    std::shared_lock<std::shared_mutex> guard(stripe.lock);
+    return (stripe.table.get(key) != nullptr);
+}
+
+KVHTEMP
+bool concurrentTable<Key, Value, HashFunc, Bucket>::remove(Key key)
+{
+    Stripe& stripe = stripeFor(key);
+    std::unique_lock<std::shared_mutex> guard(stripe.lock);
+    int before = stripe.table.entrySize();
+    stripe.table.remove(key);
+    return (stripe.table.entrySize() != before);
+}
+
+KVHTEMP
+template<typename Func>
+bool concurrentTable<Key, Value, HashFunc, Bucket>::update(Key key, Func func)
+{
+    Stripe& stripe = stripeFor(key);
+    std::unique_lock<std::shared_mutex> guard(stripe.lock);
+    Value* value = stripe.table.get(key);
+    if (value == nullptr)
+        return false;
+
+    func(*value);
+    return true;
+}
+
+KVHTEMP
+void concurrentTable<Key, Value, HashFunc, Bucket>::setLoadFactor(double loadFactor)
+{
+    for (int i = 0; i < stripeCount; i++)
+    {
+        std::unique_lock<std::shared_mutex> guard(stripes[i].lock);
+        stripes[i].table.setLoadFactor(loadFactor);
+    }
+}
+
+KVHTEMP
+void concurrentTable<Key, Value, HashFunc, Bucket>::rehash(size_t buckets)
+{
+    size_t perStripe = (buckets + stripeCount - 1) / stripeCount;
+    for (int i = 0; i < stripeCount; i++)
+    {
+        std::unique_lock<std::shared_mutex> guard(stripes[i].lock);
+        stripes[i].table.rehash(perStripe);
+    }
+}
+
+KVHTEMP
+int concurrentTable<Key, Value, HashFunc, Bucket>::stripeSize() const
+{
+    return stripeCount;
+}
+
+KVHTEMP
+int concurrentTable<Key, Value, HashFunc, Bucket>::entrySize() const
+{
+    int total = 0;
+    for (int i = 0; i < stripeCount; i++)
+    {
+        std::shared_lock<std::shared_mutex> guard(stripes[i].lock);
+        total += stripes[i].table.entrySize();
+    }
+    return total;
+}
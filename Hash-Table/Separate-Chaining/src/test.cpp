@@ -1,6 +1,11 @@
 #include "../include/chainTable.h"
+#include "../include/concurrentTable.h"
 #include <chrono>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 static const char* names[] = {
     "Alice",
@@ -26,6 +31,37 @@ struct charHash
     }
 };
 
+// Worst possible hash function.
+struct constantHash
+{
+    Hash operator()(int /* key */)
+    {
+        return 7;
+    }
+};
+
+// Entries seen walking a table that has no buckets yet,
+// whole and in halves, which should be none.
+template<template<typename> class Bucket>
+static int walkEmpty()
+{
+    chainTable<int, int, Hasher<int>, Bucket> table;
+    const chainTable<int, int, Hasher<int>, Bucket>& constTable = table;
+    int seen = 0;
+    for (auto entry : table)
+        seen += entry.second + 1;
+    for (auto entry : constTable)
+        seen += entry.second + 1;
+    for (int part = 0; part < 2; part++)
+    {
+        for (auto entry : table.range(part, 2))
+            seen += entry.second + 1;
+        for (auto entry : constTable.range(part, 2))
+            seen += entry.second + 1;
+    }
+    return seen;
+}
+
 int main()
 {
     chainTable<const char *, int, charHash> chartable;
@@ -64,5 +100,123 @@ int main()
     auto time = duration_cast<milliseconds>(finish - start);
     std::cout << "Time: " << (long double) time.count() / 1000 << '\n';
 
+    // Same workload, growing a few buckets at a time.
+    chainTable<int, int> incremental;
+    incremental.setIncremental(true);
+    int rehashingInserts = 0;
+    for (int i = 0; i < 500; i++)
+    {
+        incremental.add(i, i + 1);
+        rehashingInserts += incremental.rehashing();
+    }
+
+    int found = 0;
+    for (int i = 0; i < 500; i++)
+        found += (*incremental.get(i) == i + 1);
+    std::cout << "Incremental: found " << found << " of 500 (inserts during a rehash: "
+        << rehashingInserts << ")\n";
+
+    chainTable<int, int> merged;
+    merged.merge(incremental);
+    for (int i = 0; i < 500; i += 2)
+        incremental.remove(i);
+    std::cout << "After removing: " << incremental.entrySize()
+        << " left, merged copy has " << merged.entrySize() << '\n';
+
+    // Entries stored contiguously in each bucket.
+    chainTable<int, int, Hasher<int>, FlatBucket> flat;
+    for (int i = 0; i < 500; i++)
+        flat[i] = i * 2;
+    for (int i = 0; i < 500; i += 3)
+        flat.remove(i);
+    found = 0;
+    for (int i = 0; i < 500; i++)
+        found += (flat.get(i) != nullptr);
+    std::cout << "Flat buckets: " << found << " of 500 left, "
+        << flat.bucketSize() << " buckets in use\n";
+
+    // Lookups don't move entries along a rehash, so a pointer
+    // from get() survives other get() calls, even though flat
+    // buckets move their entries by value.
+    chainTable<int, int, Hasher<int>, FlatBucket> flatGrowing;
+    flatGrowing.setIncremental(true);
+    for (int i = 0; !flatGrowing.rehashing(); i++)
+        flatGrowing.add(i, i * 3);
+    int* kept = flatGrowing.get(1);
+    for (int i = 0; i < 1000; i++)
+        flatGrowing.get(-1);
+    std::cout << "Kept pointer: " << *kept << ", still the same: "
+        << (kept == flatGrowing.get(1)) << '\n';
+
+    // Every key lands in the same bucket, which turns
+    // into a tree and back as it grows and shrinks.
+    chainTable<int, int, constantHash, TreeBucket> colliding;
+    for (int i = 0; i < 100; i++)
+        colliding[i] = i;
+    auto stats = colliding.bucketStats();
+    std::cout << "Colliding keys: longest bucket " << stats.longest
+        << ", trees " << stats.trees << ", found 42: " << *colliding.get(42) << '\n';
+    for (int i = 0; i < 95; i++)
+        colliding.remove(i);
+    stats = colliding.bucketStats();
+    std::cout << "After removing: longest bucket " << stats.longest
+        << ", trees " << stats.trees << ", found 99: " << *colliding.get(99) << '\n';
+
+    stats = incremental.bucketStats();
+    std::cout << "Int table: " << stats.used << " of " << stats.buckets
+        << " buckets used, average length " << stats.average << '\n';
+
+    // Walking entries in place, in halves (as two threads would).
+    long sum = 0;
+    for (auto entry : merged)
+        entry.second += 1;
+    for (int part = 0; part < 2; part++)
+        for (auto entry : merged.range(part, 2))
+            sum += entry.second;
+    std::cout << "Iterated sum: " << sum << " (expected " << 500 * 501 / 2 + 500 << ")\n";
+
+    int walked = 0;
+    for (auto entry : static_cast<const chainTable<int, int, constantHash, TreeBucket>&>(colliding))
+        walked += (*colliding.get(entry.first) == entry.second);
+    std::cout << "Walked " << walked << " colliding entries\n";
+    std::cout << "Empty tables walked: " << walkEmpty<ListBucket>() << ' '
+        << walkEmpty<FlatBucket>() << ' ' << walkEmpty<TreeBucket>() << '\n';
+
+    // Four threads writing their own keys and bumping a shared counter.
+    concurrentTable<int, int> shared;
+    shared.add(-1, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; t++)
+    {
+        workers.emplace_back([&shared, t]()
+        {
+            for (int i = t * 1000; i < (t + 1) * 1000; i++)
+            {
+                shared.add(i, i);
+                shared.update(-1, [](int& count) { count++; });
+            }
+            for (int i = t * 1000; i < (t + 1) * 1000; i += 2)
+                shared.remove(i);
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    int counter = 0;
+    shared.get(-1, counter);
+    std::cout << "Concurrent: " << shared.entrySize() - 1 << " entries left, counter "
+        << counter << ", has 999: " << shared.contains(999) << '\n';
+
+    // String keys looked up without building a std::string.
+    chainTable<std::string, int> words;
+    words.add("alpha", 1);
+    words["beta"] = 2;
+    std::string_view request = "GET beta HTTP/1.1";
+    std::string_view word = request.substr(4, 4);
+    words.set("alpha", 10);
+    words.remove(std::string_view("gamma"));
+    std::cout << "Words: " << *words.get(word) << ", " << *words.get("alpha")
+        << ", missing: " << (words.get("gamma") == nullptr) << '\n';
+
     return 0;
 }
\ No newline at end of file
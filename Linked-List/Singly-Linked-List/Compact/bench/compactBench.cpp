@@ -0,0 +1,80 @@
+// Memory footprint, churn and traversal of CompactList
+// against LinkedList for a small element type.
+
+#include "../include/compactList.h"
+#include "../../Regular/include/linkedList.h"
+#include "../../../../General/benchTimer.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std::chrono;
+
+// Heap allocator that keeps track of the peak number
+// of bytes requested (not counting malloc's own headers).
+class CountingAllocator : public HeapAllocator
+{
+    public:
+        size_t live = 0;
+        size_t peak = 0;
+        size_t calls = 0;
+
+        void* allocate(size_t size, size_t alignment) override
+        {
+            live += size;
+            peak = (live > peak ? live : peak);
+            calls++;
+            return HeapAllocator::allocate(size, alignment);
+        }
+
+        void deallocate(void* ptr, size_t size, size_t alignment) override
+        {
+            live -= size;
+            HeapAllocator::deallocate(ptr, size, alignment);
+        }
+};
+
+template<typename List>
+static void run(const char* name, int n, int rounds)
+{
+    CountingAllocator counter;
+    {
+        List list(&counter);
+        std::srand(1);
+
+        auto start = steady_clock::now();
+        for (int i = 0; i < n; i++)
+            list.append(i);
+        std::cout << name << " build: " << elapsed(start) << " ms, ";
+
+        // Erase near the front and put new elements at
+        // the back, so the links get scattered.
+        start = steady_clock::now();
+        for (int i = 0; i < n / 2; i++)
+        {
+            list.erase(std::rand() % 64);
+            list.append(i);
+        }
+        std::cout << "churn: " << elapsed(start) << " ms, ";
+
+        long sum = 0;
+        start = steady_clock::now();
+        for (int round = 0; round < rounds; round++)
+            for (int element : list)
+                sum += element;
+        std::cout << "traversal: " << elapsed(start) << " ms (checksum " << sum << ")\n";
+    }
+    std::cout << "    peak bytes: " << counter.peak << " ("
+        << (long double) counter.peak / n << " per element), allocations: " << counter.calls << '\n';
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 1000000);
+    const int rounds = 10;
+
+    run<LinkedList<int>>("LinkedList<int> ", n, rounds);
+    run<CompactList<int>>("CompactList<int>", n, rounds);
+    return 0;
+}
@@ -0,0 +1 @@
+#include "compactList.h"
\ No newline at end of file
@@ -0,0 +1,825 @@
+/*  A singly linked list whose nodes all live in one Array and link through 32-bit indices.
+*   Erased nodes go on a free chain and are reused by later inserts, so the buffer only grows when
+*   every slot is in use. Since links are indices rather than pointers, the whole list is a single
+*   relocatable buffer: it can be copied or moved byte for byte and the links stay valid.
+*   Same interface as LinkedList, except that front(), back(), at() and get() return a pointer to the
+*   element. Those pointers (and iterators) are invalidated when the buffer grows.
+*/
+
+#pragma once
+#include "../../General/list.h"
+#include "../../../../Dynamic-Array/include/array.h"
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#define TEMP template<typename T>
+
+TEMP
+struct CompactNode
+{
+    T object;
+    uint32_t next;
+
+    CompactNode(T object, uint32_t next);
+};
+
+TEMP
+CompactNode<T>::CompactNode(T object, uint32_t next) :
+    object(std::move(object)), next(next) {}
+
+// Lets the node buffer grow with memcpy whenever T can.
+TEMP
+struct isRelocatable<CompactNode<T>> : isRelocatable<T> {};
+
+TEMP
+class CompactList
+{
+    public:
+        // Marks the end of a chain.
+        static constexpr uint32_t NIL = UINT32_MAX;
+
+    private:
+        Array<CompactNode<T>> nodes;
+        uint32_t head;
+        uint32_t tail;
+        // Erased slots, linked through next.
+        uint32_t freeList;
+        int listLength;
+        SortCase isSorted;
+
+        CompactNode<T>* base();
+        const CompactNode<T>* base() const;
+        uint32_t newNode(T object);
+        // Links a new node after previous (at the head if previous is NIL).
+        void linkAfter(uint32_t previous, T object);
+        // Unlinks current (which follows previous) and frees its slot.
+        T unlinkAfter(uint32_t previous, uint32_t current);
+        // Index of the node at position, and of the one before it.
+        uint32_t walk(int position, uint32_t* previous) const;
+        template<typename Compare>
+        uint32_t mergeChains(uint32_t first, uint32_t second,
+            Compare& compare, uint32_t* last);
+
+    public:
+        CompactList();
+        explicit CompactList(Allocator* alloc);
+        CompactList(const CompactList<T>& other);
+        CompactList& operator=(const CompactList<T>& other);
+        CompactList(CompactList<T>&& other);
+        CompactList& operator=(CompactList<T>&& other);
+
+        int length() const;
+        // Slots in the buffer, free ones included.
+        int slots() const;
+        Allocator* allocator() const;
+        T* front();
+        T* back();
+
+        // Add new node.
+
+        void prepend(T object);
+        void append(T object);
+        void insert(T object, int position);
+
+        // Find a node.
+
+        int position(const T& object, int start = 0) const;
+
+        // Remove node(s).
+
+        T erase(int position);
+        void remove(const T& object);
+        T pop();
+        void popn(int n);
+
+        // Check for and retrieve nodes.
+
+        bool has(const T& object) const;
+        T* at(int position);
+        T* get(const T& object);
+
+        // Manage list.
+
+        // Stable merge sort that relinks indices
+        // (no allocation, no copies of T).
+        void sort(bool ascending = true);
+        // compare(a, b) is true if a has to come before b.
+        template<typename Compare>
+        void sort(Compare compare);
+        void merge(const CompactList<T>& other);
+        // Both lists must already be sorted in ascending order.
+        // Moves other's elements in and leaves other empty.
+        void mergeSorted(CompactList<T>& other);
+        // Rewrites the buffer in list order with no free slots,
+        // so a traversal reads it front to back.
+        void compact();
+
+        // Manage sorted list.
+        // Same rules as LinkedList: these assume
+        // the list is already sorted.
+
+        bool sorted();
+        void sortAdd(T object);
+        int sortPosition(const T& object, int start = 0) const;
+        bool sortHas(const T& object) const;
+        void sortRemove(const T& object);
+
+        class iterator
+        {
+            private:
+                CompactNode<T>* buffer;
+                uint32_t index;
+
+            public:
+                iterator(CompactNode<T>* buffer, uint32_t index);
+
+                T& operator*() const;
+                iterator& operator++();
+                iterator operator++(int);
+                bool operator==(const iterator& other) const;
+                bool operator!=(const iterator& other) const;
+        };
+
+        class const_iterator
+        {
+            private:
+                const CompactNode<T>* buffer;
+                uint32_t index;
+
+            public:
+                const_iterator(const CompactNode<T>* buffer, uint32_t index);
+
+                const T& operator*() const;
+                const_iterator& operator++();
+                const_iterator operator++(int);
+                bool operator==(const const_iterator& other) const;
+                bool operator!=(const const_iterator& other) const;
+        };
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+};
+
+// Nothing points into the list object, only into its buffer.
+TEMP
+struct isRelocatable<CompactList<T>> : std::true_type {};
+
+TEMP
+CompactList<T>::CompactList() :
+    CompactList(defaultAllocator()) {}
+
+TEMP
+CompactList<T>::CompactList(Allocator* alloc) :
+    nodes(alloc), head(NIL), tail(NIL), freeList(NIL),
+    listLength(0), isSorted(INVALID) {}
+
+// Free slots are copied too, so every index carries over as is.
+TEMP
+CompactList<T>::CompactList(const CompactList<T>& other) :
+    nodes(other.nodes), head(other.head), tail(other.tail),
+    freeList(other.freeList), listLength(other.listLength),
+    isSorted(other.isSorted) {}
+
+TEMP
+CompactList<T>& CompactList<T>::operator=(const CompactList<T>& other)
+{
+    if (this != &other)
+    {
+        this->nodes = other.nodes;
+        this->head = other.head;
+        this->tail = other.tail;
+        this->freeList = other.freeList;
+        this->listLength = other.listLength;
+        this->isSorted = other.isSorted;
+    }
+
+    return *this;
+}
+
+TEMP
+CompactList<T>::CompactList(CompactList<T>&& other) :
+    nodes(std::move(other.nodes)), head(other.head), tail(other.tail),
+    freeList(other.freeList), listLength(other.listLength),
+    isSorted(other.isSorted)
+{
+    other.head = NIL;
+    other.tail = NIL;
+    other.freeList = NIL;
+    other.listLength = 0;
+    other.isSorted = INVALID;
+}
+
+TEMP
+CompactList<T>& CompactList<T>::operator=(CompactList<T>&& other)
+{
+    if (this != &other)
+    {
+        this->nodes = std::move(other.nodes);
+        this->head = other.head;
+        this->tail = other.tail;
+        this->freeList = other.freeList;
+        this->listLength = other.listLength;
+        this->isSorted = other.isSorted;
+
+        other.head = NIL;
+        other.tail = NIL;
+        other.freeList = NIL;
+        other.listLength = 0;
+        other.isSorted = INVALID;
+    }
+
+    return *this;
+}
+
+TEMP
+CompactNode<T>* CompactList<T>::base()
+{
+    return nodes.front();
+}
+
+TEMP
+const CompactNode<T>* CompactList<T>::base() const
+{
+    return nodes.front();
+}
+
+TEMP
+uint32_t CompactList<T>::newNode(T object)
+{
+    if (freeList != NIL)
+    {
+        // Reuse an erased slot; its object was moved out
+        // but is still a constructed T.
+        uint32_t index = freeList;
+        CompactNode<T>& node = base()[index];
+        freeList = node.next;
+        node.object = std::move(object);
+        node.next = NIL;
+        return index;
+    }
+
+    if (nodes.count() >= NIL)
+        throw std::length_error("Too many nodes for 32-bit indices.");
+
+    uint32_t index = (uint32_t) nodes.count();
+    nodes.emplace(std::move(object), NIL);
+    return index;
+}
+
+TEMP
+void CompactList<T>::linkAfter(uint32_t previous, T object)
+{
+    uint32_t index = newNode(std::move(object));
+    CompactNode<T>* buffer = base();
+
+    if (previous == NIL)
+    {
+        buffer[index].next = head;
+        head = index;
+    }
+    else
+    {
+        buffer[index].next = buffer[previous].next;
+        buffer[previous].next = index;
+    }
+
+    if (buffer[index].next == NIL)
+        tail = index;
+    listLength++;
+}
+
+TEMP
+T CompactList<T>::unlinkAfter(uint32_t previous, uint32_t current)
+{
+    CompactNode<T>* buffer = base();
+
+    if (previous == NIL) // Removing the head.
+        head = buffer[current].next;
+    else
+        buffer[previous].next = buffer[current].next;
+    if (current == tail)
+        tail = previous;
+
+    T element = std::move(buffer[current].object);
+    buffer[current].next = freeList;
+    freeList = current;
+    listLength--;
+    return element;
+}
+
+TEMP
+uint32_t CompactList<T>::walk(int position, uint32_t* previous) const
+{
+    const CompactNode<T>* buffer = base();
+    uint32_t before = NIL;
+    uint32_t current = head;
+    for (int i = 0; i < position; i++)
+    {
+        before = current;
+        current = buffer[current].next;
+    }
+
+    if (previous != nullptr)
+        *previous = before;
+    return current;
+}
+
+TEMP
+int CompactList<T>::length() const
+{
+    return listLength;
+}
+
+TEMP
+int CompactList<T>::slots() const
+{
+    return (int) nodes.count();
+}
+
+TEMP
+Allocator* CompactList<T>::allocator() const
+{
+    return nodes.allocator();
+}
+
+TEMP
+T* CompactList<T>::front()
+{
+    return (head == NIL ? nullptr : &(base()[head].object));
+}
+
+TEMP
+T* CompactList<T>::back()
+{
+    return (tail == NIL ? nullptr : &(base()[tail].object));
+}
+
+TEMP
+void CompactList<T>::prepend(T object)
+{
+    linkAfter(NIL, std::move(object));
+    isSorted = INVALID;
+}
+
+TEMP
+void CompactList<T>::append(T object)
+{
+    linkAfter(tail, std::move(object));
+    isSorted = INVALID;
+}
+
+TEMP
+void CompactList<T>::insert(T object, int position)
+{
+    if ((position < 0) ||
+        ((position != 0) && (position >= listLength)))
+            return; // Put error-handling here.
+
+    // Same rule as LinkedList: position 0
+    // is allowed on an empty list.
+    uint32_t previous = NIL;
+    walk(position, &previous);
+    linkAfter(previous, std::move(object));
+    isSorted = INVALID;
+}
+
+TEMP
+int CompactList<T>::position(const T& object, int start) const
+{
+    if ((start < 0) || (start >= listLength))
+        return -1; // Put error-handling here.
+
+    const CompactNode<T>* buffer = base();
+    int position = start;
+    for (uint32_t i = walk(start, nullptr); i != NIL; i = buffer[i].next)
+    {
+        if (buffer[i].object == object)
+            return position;
+        position++;
+    }
+
+    return -1;
+}
+
+TEMP
+T CompactList<T>::erase(int position)
+{
+    if ((position < 0) || (position >= listLength))
+        throw std::out_of_range("Invalid position value.");
+
+    uint32_t previous = NIL;
+    uint32_t current = walk(position, &previous);
+    return unlinkAfter(previous, current);
+}
+
+TEMP
+void CompactList<T>::remove(const T& object)
+{
+    int pos = position(object);
+    if (pos != -1)
+        erase(pos);
+}
+
+TEMP
+T CompactList<T>::pop()
+{
+    return erase(listLength - 1);
+}
+
+TEMP
+void CompactList<T>::popn(int n)
+{
+    while (n > 0)
+    {
+        pop();
+        n--;
+    }
+}
+
+TEMP
+bool CompactList<T>::has(const T& object) const
+{
+    return (position(object) != -1);
+}
+
+TEMP
+T* CompactList<T>::at(int position)
+{
+    if ((position < 0) || (position >= listLength))
+        return nullptr; // Put error-handling here.
+
+    return &(base()[walk(position, nullptr)].object);
+}
+
+TEMP
+T* CompactList<T>::get(const T& object)
+{
+    int pos = position(object);
+    if (pos == -1)
+        return nullptr;
+
+    return this->at(pos);
+}
+
+// Stable: on ties, nodes from first go before nodes from second.
+// Stores the last index of the merged chain in last (if given).
+TEMP
+template<typename Compare>
+uint32_t CompactList<T>::mergeChains(uint32_t first, uint32_t second,
+    Compare& compare, uint32_t* last)
+{
+    CompactNode<T>* buffer = base();
+    uint32_t merged = NIL;
+    uint32_t* link = &merged;
+    uint32_t end = NIL;
+
+    while ((first != NIL) && (second != NIL))
+    {
+        if (compare(buffer[second].object, buffer[first].object))
+        {
+            end = second;
+            second = buffer[second].next;
+        }
+        else
+        {
+            end = first;
+            first = buffer[first].next;
+        }
+        *link = end;
+        link = &(buffer[end].next);
+    }
+
+    *link = (first != NIL ? first : second);
+    if (last != nullptr)
+    {
+        if (end == NIL)
+            end = *link;
+        while ((end != NIL) && (buffer[end].next != NIL))
+            end = buffer[end].next;
+        *last = end;
+    }
+
+    return merged;
+}
+
+TEMP
+void CompactList<T>::sort(bool ascending)
+{
+    if (ascending)
+        sort([](const T& first, const T& second) { return second > first; });
+    else
+        sort([](const T& first, const T& second) { return first > second; });
+
+    isSorted = (ascending || listLength < 2 ? SORTED : INVALID);
+}
+
+// Same bottom-up merge sort as LinkedList, on indices.
+TEMP
+template<typename Compare>
+void CompactList<T>::sort(Compare compare)
+{
+    if (listLength < 2)
+    {
+        isSorted = SORTED;
+        return;
+    }
+
+    CompactNode<T>* buffer = base();
+    uint32_t runs[32];
+    for (int i = 0; i < 32; i++)
+        runs[i] = NIL;
+    int used = 0;
+
+    while (head != NIL)
+    {
+        uint32_t carry = head;
+        head = buffer[head].next;
+        buffer[carry].next = NIL;
+
+        // Higher slots hold earlier nodes, so they go
+        // first in each merge to keep the sort stable.
+        int i = 0;
+        for (; runs[i] != NIL; i++)
+        {
+            carry = mergeChains(runs[i], carry, compare, nullptr);
+            runs[i] = NIL;
+        }
+        runs[i] = carry;
+        used = (i + 1 > used ? i + 1 : used);
+    }
+
+    for (int i = 0; i < used; i++)
+    {
+        if (runs[i] != NIL)
+            head = mergeChains(runs[i], head, compare, (i == used - 1 ? &tail : nullptr));
+    }
+
+    isSorted = INVALID;
+}
+
+TEMP
+void CompactList<T>::merge(const CompactList<T>& other)
+{
+    // Copy the count first, in case other is this list, and
+    // reserve before taking the iterator: growing the buffer
+    // would leave it pointing into the old one.
+    int count = other.listLength;
+    nodes.reserve(nodes.count() + count);
+    const_iterator it = other.begin();
+    for (int i = 0; i < count; i++, ++it)
+        linkAfter(tail, *it);
+
+    isSorted = INVALID;
+}
+
+TEMP
+void CompactList<T>::mergeSorted(CompactList<T>& other)
+{
+    if (this == &other)
+        return;
+
+    // The nodes can't be shared between buffers, so other's
+    // elements are moved into a chain of new slots first.
+    uint32_t chain = NIL;
+    uint32_t last = NIL;
+    for (T& element : other)
+    {
+        uint32_t index = newNode(std::move(element));
+        if (last == NIL)
+            chain = index;
+        else
+            base()[last].next = index;
+        last = index;
+    }
+    int otherLength = other.listLength;
+    other = CompactList<T>(other.allocator());
+
+    auto ascending = [](const T& first, const T& second) { return second > first; };
+    head = mergeChains(head, chain, ascending, &tail);
+    listLength += otherLength;
+    isSorted = SORTED;
+}
+
+TEMP
+void CompactList<T>::compact()
+{
+    Array<CompactNode<T>> packed(nodes.allocator());
+    packed.reserve(listLength);
+
+    CompactNode<T>* buffer = base();
+    for (uint32_t i = head; i != NIL; i = buffer[i].next)
+        packed.emplace(std::move(buffer[i].object), (uint32_t) packed.count() + 1);
+
+    if (listLength > 0)
+        packed[listLength - 1].next = NIL;
+
+    this->nodes = std::move(packed);
+    head = (listLength > 0 ? 0 : NIL);
+    tail = (listLength > 0 ? listLength - 1 : NIL);
+    freeList = NIL;
+}
+
+TEMP
+bool CompactList<T>::sorted()
+{
+    if (isSorted == SORTED || isSorted == UNSORTED)
+        return (isSorted == SORTED);
+
+    const CompactNode<T>* buffer = base();
+    for (uint32_t i = head; (i != NIL) && (buffer[i].next != NIL); i = buffer[i].next)
+    {
+        if (buffer[i].object > buffer[buffer[i].next].object)
+        {
+            isSorted = UNSORTED;
+            return false;
+        }
+    }
+
+    isSorted = SORTED;
+    return true;
+}
+
+TEMP
+void CompactList<T>::sortAdd(T object)
+{
+    // Links right after the last element not greater than
+    // object, without walking the list a second time.
+    const CompactNode<T>* buffer = base();
+    uint32_t previous = NIL;
+    for (uint32_t i = head; i != NIL; i = buffer[i].next)
+    {
+        if (buffer[i].object > object)
+            break;
+        previous = i;
+    }
+
+    linkAfter(previous, std::move(object));
+}
+
+TEMP
+int CompactList<T>::sortPosition(const T& object, int start) const
+{
+    if ((start < 0) || (start >= listLength))
+        return -1;
+
+    const CompactNode<T>* buffer = base();
+    int position = start;
+    for (uint32_t i = walk(start, nullptr); i != NIL; i = buffer[i].next)
+    {
+        if (buffer[i].object == object)
+            return position;
+        if (buffer[i].object > object) // It's not there.
+            break;
+        position++;
+    }
+
+    return -1;
+}
+
+TEMP
+bool CompactList<T>::sortHas(const T& object) const
+{
+    return (sortPosition(object) != -1);
+}
+
+TEMP
+void CompactList<T>::sortRemove(const T& object)
+{
+    const CompactNode<T>* buffer = base();
+    uint32_t previous = NIL;
+    for (uint32_t i = head; i != NIL; i = buffer[i].next)
+    {
+        if (buffer[i].object == object)
+        {
+            unlinkAfter(previous, i);
+            return;
+        }
+        if (buffer[i].object > object) // It's not there.
+            return;
+        previous = i;
+    }
+}
+
+// Iterator.
+
+#define CompactIter CompactList<T>::iterator
+
+TEMP
+CompactIter::iterator(CompactNode<T>* buffer, uint32_t index) :
+    buffer(buffer), index(index) {}
+
+TEMP
+T& CompactIter::operator*() const
+{
+    return buffer[index].object;
+}
+
+TEMP
+typename CompactIter& CompactIter::operator++()
+{
+    index = buffer[index].next;
+    return *this;
+}
+
+TEMP
+typename CompactIter CompactIter::operator++(int)
+{
+    iterator temp = *this;
+    index = buffer[index].next;
+    return temp;
+}
+
+TEMP
+bool CompactIter::operator==(const iterator& other) const
+{
+    return (this->index == other.index);
+}
+
+TEMP
+bool CompactIter::operator!=(const iterator& other) const
+{
+    return (this->index != other.index);
+}
+
+TEMP
+typename CompactIter CompactList<T>::begin()
+{
+    return iterator(base(), head);
+}
+
+TEMP
+typename CompactIter CompactList<T>::end()
+{
+    return iterator(base(), NIL);
+}
+
+// Constant iterator.
+
+#define constCompactIter CompactList<T>::const_iterator
+
+TEMP
+constCompactIter::const_iterator(const CompactNode<T>* buffer, uint32_t index) :
+    buffer(buffer), index(index) {}
+
+TEMP
+const T& constCompactIter::operator*() const
+{
+    return buffer[index].object;
+}
+
+TEMP
+typename constCompactIter& constCompactIter::operator++()
+{
+    index = buffer[index].next;
+    return *this;
+}
+
+TEMP
+typename constCompactIter constCompactIter::operator++(int)
+{
+    const_iterator temp = *this;
+    index = buffer[index].next;
+    return temp;
+}
+
+TEMP
+bool constCompactIter::operator==(const const_iterator& other) const
+{
+    return (this->index == other.index);
+}
+
+TEMP
+bool constCompactIter::operator!=(const const_iterator& other) const
+{
+    return (this->index != other.index);
+}
+
+TEMP
+typename constCompactIter CompactList<T>::begin() const
+{
+    return const_iterator(base(), head);
+}
+
+TEMP
+typename constCompactIter CompactList<T>::end() const
+{
+    return const_iterator(base(), NIL);
+}
+
+TEMP
+typename constCompactIter CompactList<T>::cbegin() const
+{
+    return const_iterator(base(), head);
+}
+
+TEMP
+typename constCompactIter CompactList<T>::cend() const
+{
+    return const_iterator(base(), NIL);
+}
@@ -0,0 +1,81 @@
+#include "../include/compactList.h"
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+
+int main()
+{
+    CompactList<int> list;
+
+    list.insert(1, 2); // Inserting at position 2 in empty list; doesn't do anything.
+    list.insert(1, 0); // Inserting at position 0 in empty list.
+    std::cout << *list.at(0) << '\n';
+    list.pop();
+
+    for (int i = 0; i < 10; i++)
+        list.append(i + 1);
+    list.insert(100, 3);
+    list.prepend(0);
+    std::cout << "Size: " << list.length() << ", slots: " << list.slots() << '\n';
+
+    list.erase(4);
+    list.remove(7);
+    list.append(50); // Reuses a freed slot.
+    std::cout << "After erasing (size " << list.length()
+        << ", slots " << list.slots() << "):\n";
+    for (const auto& element : list)
+        std::cout << element << ' ';
+    std::cout << '\n';
+    std::cout << "Position of 8: " << list.position(8) << '\n';
+
+    list.sort(false);
+    std::cout << "Sorted descending: ";
+    for (const auto& element : list)
+        std::cout << element << ' ';
+    std::cout << '\n';
+
+    list.sort();
+    list.sortAdd(7);
+    list.sortRemove(50);
+    std::cout << "Sorted (" << (list.sorted() ? "true" : "false") << "): ";
+    for (const auto& element : list)
+        std::cout << element << ' ';
+    std::cout << "\nHas 7: " << (list.sortHas(7) ? "true" : "false")
+        << ", back: " << *list.back() << '\n';
+
+    // The links are indices, so a byte copy of the
+    // whole list object is still a valid list.
+    alignas(CompactList<int>) unsigned char raw[sizeof(CompactList<int>)];
+    std::memcpy(raw, (void*) &list, sizeof(list));
+    new (&list) CompactList<int>(); // list gave its buffer to raw.
+    CompactList<int>& moved = *reinterpret_cast<CompactList<int>*>(raw);
+    std::cout << "Relocated: ";
+    for (const auto& element : moved)
+        std::cout << element << ' ';
+    std::cout << '\n';
+    moved.~CompactList<int>();
+
+    CompactList<std::string> first;
+    CompactList<std::string> second;
+    first.append("a");
+    first.append("c");
+    second.append("b");
+    second.append("d");
+    first.mergeSorted(second);
+    first.compact();
+    for (const auto& word : first)
+        std::cout << word << ' ';
+    std::cout << "(slots " << first.slots() << ", other has " << second.length() << ")\n";
+
+    // Merging a list into itself doubles it (and
+    // makes the node buffer grow while doing it).
+    CompactList<std::string> twice;
+    for (int i = 0; i < 20; i++)
+        twice.append("word" + std::to_string(i));
+    twice.merge(twice);
+    std::cout << "Self-merged: " << *twice.at(0) << ' ' << *twice.at(19) << ' '
+        << *twice.at(20) << ' ' << *twice.at(39) << " (length " << twice.length() << ")\n";
+
+    return 0;
+}
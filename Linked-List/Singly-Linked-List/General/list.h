@@ -1,3 +1,14 @@
+#pragma once
+#include <utility>
+
+// What a list knows about its own order.
+enum SortCase
+{
+    SORTED,
+    UNSORTED,
+    INVALID
+};
+
 template<typename T>
 struct ListNode
 {
@@ -5,6 +16,7 @@ struct ListNode
     ListNode<T>* next;
 
     ListNode();
+    ListNode(T object);
 };
 
 template<typename T>
@@ -12,4 +24,8 @@ ListNode<T>::ListNode()
 {
     // Let default constructor for T run.
     next = nullptr;
-}
\ No newline at end of file
+}
+
+template<typename T>
+ListNode<T>::ListNode(T object) :
+    object(std::move(object)), next(nullptr) {}
\ No newline at end of file
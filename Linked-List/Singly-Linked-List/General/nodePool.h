@@ -0,0 +1,30 @@
+/*  Slab pool for ListNode<T>.
+*   Nodes are carved out of large contiguous slabs (starting at firstSlab nodes and doubling up to maxSlab) and freed
+*   nodes are recycled through a free list, so a list never calls into the general-purpose heap per node and its
+*   nodes sit close together instead of scattered across the heap.
+*   Several lists can share one pool (e.g. every bucket of a chainTable) by passing it as their allocator:
+*
+*       NodePool<Entry<Key, Value>> pool;
+*       chainTable<Key, Value> table(&pool);
+*
+*   Requests larger than a node (like most bucket arrays) go to the upstream allocator; anything that fits in a
+*   node, even if it isn't one (like a small table's bucket array), is carved from the slabs.
+*   The pool has to outlive every list using it.
+*/
+
+#pragma once
+#include "list.h"
+#include "../../../Allocator/include/poolAllocator.h"
+#include <cstddef>
+
+template<typename T>
+class NodePool : public PoolAllocator
+{
+    public:
+        NodePool(size_t firstSlab = 64, size_t maxSlab = 64 * 1024,
+            Allocator* upstream = defaultAllocator());
+};
+
+template<typename T>
+NodePool<T>::NodePool(size_t firstSlab, size_t maxSlab, Allocator* upstream) :
+    PoolAllocator(sizeof(ListNode<T>), firstSlab, upstream, maxSlab) {}
@@ -0,0 +1,83 @@
+// Insert/erase throughput and traversal speed of LinkedList
+// (and chainTable chains) with and without a shared NodePool.
+
+#include "../include/linkedList.h"
+#include "../../General/nodePool.h"
+#include "../../../../Hash-Table/Separate-Chaining/include/chainTable.h"
+#include "../../../../General/benchTimer.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std::chrono;
+
+// Many lists filled in an interleaved way, then half their
+// nodes erased at random and refilled, like busy buckets.
+static void lists(const char* name, Allocator* alloc, int lists, int perList)
+{
+    LinkedList<long>* all = static_cast<LinkedList<long>*>(::operator new(sizeof(LinkedList<long>) * lists));
+    for (int i = 0; i < lists; i++)
+        new (all + i) LinkedList<long>(alloc);
+
+    auto start = steady_clock::now();
+    for (int j = 0; j < perList; j++)
+        for (int i = 0; i < lists; i++)
+            all[i].prepend(j);
+    for (int j = 0; j < perList / 2; j++)
+        for (int i = 0; i < lists; i++)
+            all[i].erase(std::rand() % all[i].length() % 8);
+    for (int j = 0; j < perList / 2; j++)
+        for (int i = 0; i < lists; i++)
+            all[i].prepend(j);
+    std::cout << name << " insert/erase: " << elapsed(start) << " ms, ";
+
+    long sum = 0;
+    start = steady_clock::now();
+    for (int round = 0; round < 10; round++)
+        for (int i = 0; i < lists; i++)
+            for (long element : all[i])
+                sum += element;
+    std::cout << "traversal: " << elapsed(start) << " ms (checksum " << sum << ")\n";
+
+    for (int i = 0; i < lists; i++)
+        all[i].~LinkedList<long>();
+    ::operator delete(all);
+}
+
+static void table(const char* name, Allocator* alloc, int n)
+{
+    chainTable<int, int> table(alloc);
+    auto start = steady_clock::now();
+    for (int i = 0; i < n; i++)
+        table.add(i, i);
+    std::cout << name << " chainTable build: " << elapsed(start) << " ms, ";
+
+    long sum = 0;
+    start = steady_clock::now();
+    for (int round = 0; round < 5; round++)
+        for (int i = 0; i < n; i++)
+            sum += *table.get(i);
+    std::cout << "lookups: " << elapsed(start) << " ms (checksum " << sum << ")\n";
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 1000000);
+
+    std::srand(1);
+    lists("Heap", defaultAllocator(), n / 16, 16);
+    {
+        NodePool<long> pool;
+        std::srand(1);
+        lists("NodePool", &pool, n / 16, 16);
+    }
+
+    table("Heap", defaultAllocator(), n);
+    {
+        NodePool<Entry<int, int>> pool;
+        table("NodePool", &pool, n);
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+// LinkedList::sort (bottom-up merge sort) against the old
+// bubble sort on random, sorted and reverse-sorted input.
+
+#include "../include/linkedList.h"
+#include "../../General/nodePool.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+
+using namespace std::chrono;
+
+// The previous implementation: bubble sort swapping
+// neighbouring objects until a pass makes no swaps.
+static void bubbleSort(LinkedList<int>& list)
+{
+    bool ordered = false;
+    while (!ordered)
+    {
+        ordered = true;
+        for (ListNode<int>* node = list.front(); node->next != nullptr; node = node->next)
+        {
+            if (node->object > node->next->object)
+            {
+                std::swap(node->object, node->next->object);
+                ordered = false;
+            }
+        }
+    }
+}
+
+static void fill(LinkedList<int>& list, int n, int kind)
+{
+    for (int i = 0; i < n; i++)
+    {
+        if (kind == 0)
+            list.prepend(std::rand());
+        else if (kind == 1)
+            list.prepend(n - i);
+        else
+            list.prepend(i);
+    }
+}
+
+template<typename Sort>
+static void run(const char* name, int n, Sort sort)
+{
+    const char* kinds[] = {"random", "sorted", "reverse"};
+    for (int kind = 0; kind < 3; kind++)
+    {
+        // A fresh pool per list, so nodes recycled from the
+        // previous run don't scramble the memory layout.
+        NodePool<int> pool;
+        LinkedList<int> list(&pool);
+        fill(list, n, kind);
+
+        auto start = high_resolution_clock::now();
+        sort(list);
+        auto time = duration_cast<microseconds>(high_resolution_clock::now() - start);
+        std::cout << name << " n=" << n << " " << kinds[kind] << ": "
+            << (long double) time.count() / 1000 << " ms"
+            << (list.sorted() ? "" : " (NOT SORTED)") << '\n';
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 100000);
+    // Bubble sort is quadratic, so it only gets a small input.
+    const int small = 5000;
+
+    run("Bubble sort", small, [](LinkedList<int>& list) { bubbleSort(list); });
+    run("Merge sort", small, [](LinkedList<int>& list) { list.sort(); });
+    run("Merge sort", n, [](LinkedList<int>& list) { list.sort(); });
+    run("Merge sort", n * 10, [](LinkedList<int>& list) { list.sort(); });
+
+    LinkedList<int> evens;
+    LinkedList<int> odds;
+    for (int i = n * 10; i > 0; i -= 2)
+    {
+        evens.prepend(i);
+        odds.prepend(i - 1);
+    }
+    auto start = high_resolution_clock::now();
+    evens.mergeSorted(odds);
+    auto time = duration_cast<microseconds>(high_resolution_clock::now() - start);
+    std::cout << "mergeSorted of two " << n * 5 << "-element lists: "
+        << (long double) time.count() / 1000 << " ms\n";
+
+    return 0;
+}
@@ -1,36 +1,48 @@
 #pragma once
 #include "../../General/list.h"
+#include "../../../../Allocator/include/allocator.h"
+#include "../../../../Dynamic-Array/include/relocatable.h"
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #define TEMP template<typename T>
 
-enum SortCase
-{
-    SORTED,
-    UNSORTED,
-    INVALID
-};
-
 TEMP
 class LinkedList
 {
     private:
         ListNode<T>* head;
+        // Last node, so append() doesn't walk the list.
+        ListNode<T>* tail;
         int listLength;
         SortCase isSorted;
+        // Every node comes from (and goes back to) here.
+        Allocator* alloc;
 
-        void swap(ListNode<T>* first, ListNode<T>* second);
+        ListNode<T>* newNode(T object);
+        void freeNode(ListNode<T>* node);
         void clear();
+        // Empties other and returns its nodes as a chain owned by
+        // this list's allocator (relinked, or moved into new nodes
+        // if the allocators differ). Stores the chain's last node in last.
+        ListNode<T>* takeNodes(LinkedList<T>& other, ListNode<T>** last);
+        template<typename Compare>
+        static ListNode<T>* mergeChains(ListNode<T>* first, ListNode<T>* second,
+            Compare& compare, ListNode<T>** last);
     
     public:
         LinkedList();
+        explicit LinkedList(Allocator* alloc);
         LinkedList(const LinkedList<T>& other);
         LinkedList& operator=(const LinkedList<T>& other);
         LinkedList(LinkedList<T>&& other);
         LinkedList& operator=(LinkedList<T>&& other);
         ~LinkedList();
 
-        int length();
+        int length() const;
+        Allocator* allocator() const;
         ListNode<T>* front();
         // Returns pointer to last node.
         ListNode<T>* back();
@@ -48,6 +60,9 @@ class LinkedList
         // Remove node(s).
 
         T erase(int position);
+        // Removes the node after previous (the head if previous
+        // is nullptr) without walking the list to find it.
+        void eraseAfter(ListNode<T>* previous);
         void remove(T object);
         T pop();
         void popn(int n);
@@ -60,8 +75,21 @@ class LinkedList
 
         // Manage list.
 
+        // Stable merge sort that relinks nodes (no allocation,
+        // no copies of T).
         void sort(bool ascending = true);
+        // compare(a, b) is true if a has to come before b.
+        template<typename Compare>
+        void sort(Compare compare);
         void merge(const LinkedList<T>& other);
+        // Move-merge: takes over other's nodes instead of copying them.
+        void merge(LinkedList<T>&& other);
+        // Both lists must already be sorted (in ascending order, or
+        // by compare). Takes over other's nodes in linear time and
+        // leaves other empty.
+        void mergeSorted(LinkedList<T>& other);
+        template<typename Compare>
+        void mergeSorted(LinkedList<T>& other, Compare compare);
 
         // Manage sorted list.
         // All methods (except sorted()) will
@@ -79,21 +107,37 @@ class LinkedList
         template<typename U>
         friend LinkedList<U> copy(const LinkedList<U>& list);
 
+        class iterator;
+
+        // Splicing moves every node of other into this list and
+        // leaves other empty. Nothing is copied or allocated, so it's
+        // O(1) (if both lists share an allocator; otherwise the
+        // objects are moved into new nodes).
+        void splice(LinkedList<T>& other); // At the end.
+        void splice_after(iterator position, LinkedList<T>& other);
+
+        // Single-node moves between lists that share an allocator.
+        // unlinkFront() hands the first node over to the caller
+        // (nullptr if empty); linkBack() takes one in at the end.
+        ListNode<T>* unlinkFront();
+        void linkBack(ListNode<T>* node);
+
         class iterator
         {
             private:
                 ListNode<T>* ptr;
+                friend class LinkedList<T>;
             
             public:
-                iterator(ListNode<T>* ptr);
+                iterator(ListNode<T>* ptr = nullptr);
                 iterator(const iterator& other);
                 iterator& operator=(const iterator& other);
 
                 T& operator*() const;
                 iterator& operator++();
                 iterator operator++(int);
-                bool operator==(const iterator& other);
-                bool operator!=(const iterator& other);
+                bool operator==(const iterator& other) const;
+                bool operator!=(const iterator& other) const;
         };
 
         class const_iterator
@@ -102,7 +146,7 @@ class LinkedList
                 const ListNode<T>* ptr;
             
             public:
-                const_iterator(const ListNode<T>* ptr);
+                const_iterator(const ListNode<T>* ptr = nullptr);
                 const_iterator(const const_iterator& other);
                 const_iterator& operator=(const const_iterator& other);
 
@@ -121,29 +165,63 @@ class LinkedList
         const_iterator cend() const;
 };
 
+// No node points back at the list object itself,
+// so an Array of lists (like a chainTable) can move
+// them around with memcpy.
+TEMP
+struct isRelocatable<LinkedList<T>> : std::true_type {};
+
 TEMP
 LinkedList<T>::LinkedList() :
-    head(nullptr), listLength(0),
-    isSorted(INVALID) {}
+    head(nullptr), tail(nullptr), listLength(0),
+    isSorted(INVALID), alloc(defaultAllocator()) {}
+
+TEMP
+LinkedList<T>::LinkedList(Allocator* alloc) :
+    head(nullptr), tail(nullptr), listLength(0),
+    isSorted(INVALID), alloc(alloc) {}
+
+TEMP
+ListNode<T>* LinkedList<T>::newNode(T object)
+{
+    void* memory = alloc->allocate(sizeof(ListNode<T>), alignof(ListNode<T>));
+    return new (memory) ListNode<T>(std::move(object));
+}
+
+TEMP
+void LinkedList<T>::freeNode(ListNode<T>* node)
+{
+    node->~ListNode<T>();
+    alloc->deallocate(node, sizeof(ListNode<T>), alignof(ListNode<T>));
+}
 
 TEMP
 void LinkedList<T>::clear()
 {
+    // Nothing to run or give back node by node;
+    // the allocator reclaims everything at once.
+    if (std::is_trivially_destructible_v<T> && alloc->releasesInBulk())
+        head = nullptr;
+
     ListNode<T>* current = head;
     ListNode<T>* temp = nullptr;
     while (current != nullptr)
     {
         temp = current;
         current = current->next;
-        delete temp;
+        freeNode(temp);
     }
 
+    head = nullptr;
+    tail = nullptr;
     listLength = 0;
     isSorted = INVALID;
 }
 
+// The copy uses the same allocator as other.
 TEMP
-LinkedList<T>::LinkedList(const LinkedList<T>& other)
+LinkedList<T>::LinkedList(const LinkedList<T>& other) :
+    head(nullptr), tail(nullptr), listLength(0), alloc(other.alloc)
 {
     for (ListNode<T>* node = other.head; node != nullptr; node = node->next)
         this->append(node->object);
@@ -173,10 +251,13 @@ TEMP
 LinkedList<T>::LinkedList(LinkedList<T>&& other)
 {
     this->head = other.head;
+    this->tail = other.tail;
     this->listLength = other.listLength;
     this->isSorted = other.isSorted;
+    this->alloc = other.alloc;
 
     other.head = nullptr;
+    other.tail = nullptr;
     other.listLength = 0;
     other.isSorted = INVALID;
 }
@@ -186,11 +267,15 @@ LinkedList<T>& LinkedList<T>::operator=(LinkedList<T>&& other)
 {
     this->clear();
     
+    // The nodes still belong to other's allocator.
     this->head = other.head;
+    this->tail = other.tail;
     this->listLength = other.listLength;
     this->isSorted = other.isSorted;
+    this->alloc = other.alloc;
 
     other.head = nullptr;
+    other.tail = nullptr;
     other.listLength = 0;
     other.isSorted = INVALID;
 
@@ -204,11 +289,17 @@ LinkedList<T>::~LinkedList()
 }
 
 TEMP
-int LinkedList<T>::length()
+int LinkedList<T>::length() const
 {
     return listLength;
 }
 
+TEMP
+Allocator* LinkedList<T>::allocator() const
+{
+    return alloc;
+}
+
 TEMP
 ListNode<T>* LinkedList<T>::front()
 {
@@ -218,41 +309,32 @@ ListNode<T>* LinkedList<T>::front()
 TEMP
 ListNode<T>* LinkedList<T>::back()
 {
-    // Temporarily.
-    // We can mimic std::list and make
-    // the last node a dummy sentinel node.
-    return nullptr;
+    return tail;
 }
 
 TEMP
 void LinkedList<T>::prepend(T object)
 {
-    ListNode<T>* newNode = new ListNode<T>;
-    newNode->object = object;
-    newNode->next = head;
-    head = newNode;
+    ListNode<T>* node = newNode(std::move(object));
+    node->next = head;
+    head = node;
+    if (tail == nullptr) // Was empty.
+        tail = node;
     listLength++;
 }
 
 TEMP
 void LinkedList<T>::append(T object)
 {
-    ListNode<T>* newNode = new ListNode<T>;
-    newNode->object = object;
-    newNode->next = nullptr;
+    ListNode<T>* node = newNode(std::move(object));
     listLength++;
 
     if (head == nullptr) // Empty list.
-    {
-        head = newNode;
-        return;
-    }
-    
-    ListNode<T>* temp = head;
-    while (temp->next != nullptr)
-        temp = temp->next;
-    
-    temp->next = newNode;
+        head = node;
+    else
+        tail->next = node;
+
+    tail = node;
 }
 
 TEMP
@@ -273,8 +355,7 @@ void LinkedList<T>::insert(T object, int position)
         return;
     }
     
-    ListNode<T>* newNode = new ListNode<T>;
-    newNode->object = object;
+    ListNode<T>* node = newNode(std::move(object));
 
     ListNode<T>* previous = nullptr;
     ListNode<T>* current = head;
@@ -285,11 +366,11 @@ void LinkedList<T>::insert(T object, int position)
     }
 
     if (previous == nullptr) // We're adding it at the beginning.
-        head = newNode;
+        head = node;
     else
-        previous->next = newNode;
+        previous->next = node;
     
-    newNode->next = current;
+    node->next = current;
     listLength++;
 }
 
@@ -332,22 +413,42 @@ T LinkedList<T>::erase(int position)
     }
 
     listLength--;
+    if (current == tail)
+        tail = previous;
 
     if (previous == nullptr) // Removing the head.
     {
         ListNode<T>* temp = head;
-        T element = head->object;
+        T element = std::move(head->object);
         head = head->next;
-        delete temp;
+        freeNode(temp);
         return element;
     }
 
     previous->next = current->next;
-    T element = current->object;
-    delete current;
+    T element = std::move(current->object);
+    freeNode(current);
     return element;
 }
 
+TEMP
+void LinkedList<T>::eraseAfter(ListNode<T>* previous)
+{
+    ListNode<T>* current = (previous == nullptr ? head : previous->next);
+    if (current == nullptr)
+        return;
+
+    if (previous == nullptr)
+        head = current->next;
+    else
+        previous->next = current->next;
+    if (current == tail)
+        tail = previous;
+
+    listLength--;
+    freeNode(current);
+}
+
 TEMP
 void LinkedList<T>::remove(T object)
 {
@@ -404,63 +505,159 @@ ListNode<T>* LinkedList<T>::get(T object) const
 }
 
 TEMP
-void LinkedList<T>::swap(ListNode<T>* first, ListNode<T>* second)
+ListNode<T>* LinkedList<T>::takeNodes(LinkedList<T>& other, ListNode<T>** last)
 {
-    T tempObj = first->object;
-    first->object = second->object;
-    second->object = tempObj;
+    ListNode<T>* chain = other.head;
+    *last = other.tail;
+
+    if (other.alloc != this->alloc)
+    {
+        // The nodes have to go back to other's allocator,
+        // so only the objects move over.
+        *last = nullptr;
+        chain = nullptr;
+        for (ListNode<T>* node = other.head; node != nullptr; node = node->next)
+        {
+            ListNode<T>* copy = newNode(std::move(node->object));
+            if (*last == nullptr)
+                chain = copy;
+            else
+                (*last)->next = copy;
+            *last = copy;
+        }
+        other.clear();
+        return chain;
+    }
+
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.listLength = 0;
+    other.isSorted = INVALID;
+    return chain;
+}
+
+// Stable: on ties, nodes from first go before nodes from second.
+// Stores the last node of the merged chain in last (if given).
+TEMP
+template<typename Compare>
+ListNode<T>* LinkedList<T>::mergeChains(ListNode<T>* first, ListNode<T>* second,
+    Compare& compare, ListNode<T>** last)
+{
+    // Link to fill in next, so no dummy node (or T) is needed.
+    ListNode<T>* merged = nullptr;
+    ListNode<T>** link = &merged;
+    ListNode<T>* tail = nullptr;
+
+    while ((first != nullptr) && (second != nullptr))
+    {
+        if (compare(second->object, first->object))
+        {
+            tail = second;
+            second = second->next;
+        }
+        else
+        {
+            tail = first;
+            first = first->next;
+        }
+        *link = tail;
+        link = &(tail->next);
+    }
+
+    *link = (first != nullptr ? first : second);
+    if (last != nullptr)
+    {
+        if (tail == nullptr)
+            tail = *link;
+        while ((tail != nullptr) && (tail->next != nullptr))
+            tail = tail->next;
+        *last = tail;
+    }
+
+    return merged;
 }
 
 TEMP
-// Using bubble sort.
 void LinkedList<T>::sort(bool ascending)
 {
-    // We assume the list is currently unsorted
-    // when this method is called, so we don't
-    // check for the value of isSorted.
+    if (ascending)
+        sort([](const T& first, const T& second) { return second > first; });
+    else
+        sort([](const T& first, const T& second) { return first > second; });
 
+    // sorted() means ascending order; a descending
+    // list has to be checked again if asked.
+    isSorted = (ascending || listLength < 2 ? SORTED : INVALID);
+}
+
+// Bottom-up merge sort, done like a binary counter:
+// runs[i] holds a sorted run of 2^i nodes (or nothing).
+// Each node is carried up through the filled slots, so merges
+// stay small and recent (cache-friendly) until the very end.
+TEMP
+template<typename Compare>
+void LinkedList<T>::sort(Compare compare)
+{
     if ((head == nullptr) || (head->next == nullptr))
     {
         // Empty list or only one element; nothing to sort.
         isSorted = SORTED;
         return;
     }
-    
-    bool ordered = false;
 
-    while (!ordered)
+    // Enough for 2^64 nodes.
+    ListNode<T>* runs[64] = {};
+    int used = 0;
+
+    while (head != nullptr)
     {
-        ordered = true;
-        ListNode<T>* first = head;
-        ListNode<T>* second = head->next;
+        ListNode<T>* carry = head;
+        head = head->next;
+        carry->next = nullptr;
 
-        for (int i = 0; i < listLength - 1; i++)
+        // Higher slots hold earlier nodes, so they go
+        // first in each merge to keep the sort stable.
+        int i = 0;
+        for (; runs[i] != nullptr; i++)
         {
-            if (ascending)
-            {
-                if (first->object > second->object)
-                {
-                    swap(first, second);
-                    ordered = false;
-                }
-            }
-            else
-            {
-                if (first->object < second->object)
-                {
-                    swap(first, second);
-                    ordered = false;
-                }
-            }
-
-            first = second;
-            second = second->next;
+            carry = mergeChains(runs[i], carry, compare, nullptr);
+            runs[i] = nullptr;
         }
+        runs[i] = carry;
+        used = (i + 1 > used ? i + 1 : used);
+    }
+
+    for (int i = 0; i < used; i++)
+    {
+        if (runs[i] != nullptr)
+            head = mergeChains(runs[i], head, compare, (i == used - 1 ? &tail : nullptr));
     }
 
+    // We can't tell what order a custom comparator gives.
+    isSorted = INVALID;
+}
+
+TEMP
+void LinkedList<T>::mergeSorted(LinkedList<T>& other)
+{
+    mergeSorted(other, [](const T& first, const T& second) { return second > first; });
     isSorted = SORTED;
 }
 
+TEMP
+template<typename Compare>
+void LinkedList<T>::mergeSorted(LinkedList<T>& other, Compare compare)
+{
+    if (this == &other)
+        return;
+
+    int otherLength = other.listLength;
+    ListNode<T>* last = nullptr;
+    head = mergeChains(head, takeNodes(other, &last), compare, &tail);
+    listLength += otherLength;
+    isSorted = INVALID;
+}
+
 TEMP
 void LinkedList<T>::merge(const LinkedList<T>& other)
 {
@@ -477,6 +674,83 @@ void LinkedList<T>::merge(const LinkedList<T>& other)
     isSorted = INVALID;
 }
 
+TEMP
+void LinkedList<T>::merge(LinkedList<T>&& other)
+{
+    splice(other);
+}
+
+TEMP
+void LinkedList<T>::splice(LinkedList<T>& other)
+{
+    if ((this == &other) || (other.head == nullptr))
+        return;
+
+    int otherLength = other.listLength;
+    ListNode<T>* last = nullptr;
+    ListNode<T>* chain = takeNodes(other, &last);
+
+    if (head == nullptr)
+        head = chain;
+    else
+        tail->next = chain;
+
+    tail = last;
+    listLength += otherLength;
+    isSorted = INVALID;
+}
+
+TEMP
+void LinkedList<T>::splice_after(iterator position, LinkedList<T>& other)
+{
+    if (position.ptr == nullptr)
+        throw std::out_of_range("Cannot splice after end().");
+
+    if ((this == &other) || (other.head == nullptr))
+        return;
+
+    int otherLength = other.listLength;
+    ListNode<T>* last = nullptr;
+    ListNode<T>* chain = takeNodes(other, &last);
+
+    last->next = position.ptr->next;
+    position.ptr->next = chain;
+    if (tail == position.ptr)
+        tail = last;
+
+    listLength += otherLength;
+    isSorted = INVALID;
+}
+
+TEMP
+ListNode<T>* LinkedList<T>::unlinkFront()
+{
+    ListNode<T>* node = head;
+    if (node == nullptr)
+        return nullptr;
+
+    head = node->next;
+    if (head == nullptr)
+        tail = nullptr;
+    node->next = nullptr;
+    listLength--;
+    return node;
+}
+
+TEMP
+void LinkedList<T>::linkBack(ListNode<T>* node)
+{
+    node->next = nullptr;
+    if (head == nullptr)
+        head = node;
+    else
+        tail->next = node;
+
+    tail = node;
+    listLength++;
+    isSorted = INVALID;
+}
+
 TEMP
 bool LinkedList<T>::sorted()
 {
@@ -568,7 +842,7 @@ void LinkedList<T>::sortRemove(T object)
 TEMP
 LinkedList<T> copy(const LinkedList<T>& list)
 {
-    LinkedList<T> newList;
+    LinkedList<T> newList(list.alloc);
 
     for (ListNode<T>* node = list.head; node != nullptr; node = node->next)
         // Uses copy constructor(?) for T object.
@@ -620,13 +894,13 @@ typename LLIter LLIter::operator++(int n)
 }
 
 TEMP
-bool LLIter::operator==(const LLIter& other)
+bool LLIter::operator==(const LLIter& other) const
 {
     return (this->ptr == other.ptr);
 }
 
 TEMP
-bool LLIter::operator!=(const LLIter& other)
+bool LLIter::operator!=(const LLIter& other) const
 {
     return (this->ptr != other.ptr);
 }
@@ -640,7 +914,7 @@ typename LLIter LinkedList<T>::begin()
 TEMP
 typename LLIter LinkedList<T>::end()
 {
-    return iterator(back());
+    return iterator(nullptr);
 }
 
 // Const iterator implementation.
@@ -659,6 +933,7 @@ TEMP
 typename constListIter& constListIter::operator=(const constListIter& other)
 {
     this->ptr = other.ptr;
+    return *this;
 }
 
 TEMP
@@ -697,23 +972,23 @@ bool constListIter::operator!=(const constListIter& other) const
 TEMP
 typename constListIter LinkedList<T>::begin() const
 {
-    return const_iterator(front());
+    return const_iterator(head);
 }
 
 TEMP
 typename constListIter LinkedList<T>::end() const
 {
-    return const_iterator(back());
+    return const_iterator(nullptr);
 }
 
 TEMP
 typename constListIter LinkedList<T>::cbegin() const
 {
-    return const_iterator(front());
+    return const_iterator(head);
 }
 
 TEMP
 typename constListIter LinkedList<T>::cend() const
 {
-    return const_iterator(back());
+    return const_iterator(nullptr);
 }
\ No newline at end of file
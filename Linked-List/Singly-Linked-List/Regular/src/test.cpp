@@ -1,4 +1,5 @@
 #include "../include/linkedList.h"
+#include "../../General/nodePool.h"
 #include <iostream>
 
 int main()
@@ -31,6 +32,12 @@ int main()
     std::cout << "After sorting:\n";
     list.sort();
 
+    for (const auto& element : list)
+        std::cout << element << '\n';
+
+    std::cout << "After sorting by last digit:\n";
+    list.sort([](int first, int second) { return first % 10 < second % 10; });
+
     for (const auto& element : list)
         std::cout << element << '\n';
 
@@ -50,8 +57,37 @@ int main()
     list3.sortAdd(1);
     std::cout << "Position: " << list3.sortPosition(3) << '\n';
 
+    LinkedList<int> list4;
+    list4.append(0);
+    list4.append(3);
+    list3.mergeSorted(list4);
+    std::cout << "After sorted merge (sorted: "
+        << (list3.sorted() ? "true" : "false") << "):\n";
+
     for (const auto& element : list3)
         std::cout << element << '\n';
 
+    NodePool<int> pool;
+    LinkedList<int> pooled1(&pool);
+    LinkedList<int> pooled2(&pool);
+    for (int i = 0; i < 5; i++)
+    {
+        pooled1.append(i);
+        pooled2.prepend(i);
+    }
+    pooled1.erase(2);
+    std::cout << "Pooled nodes in use: " << pool.inUse() << '\n';
+
+    pooled1.splice(pooled2);
+    LinkedList<int> list5;
+    list5.append(7);
+    list5.append(8);
+    pooled1.splice_after(pooled1.begin(), list5);
+    std::cout << "After splice (size " << pooled1.length()
+        << ", back " << pooled1.back()->object << "):\n";
+    for (const auto& element : pooled1)
+        std::cout << element << ' ';
+    std::cout << '\n';
+
     return 0;
 }
\ No newline at end of file
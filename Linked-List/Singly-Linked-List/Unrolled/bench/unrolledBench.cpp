@@ -0,0 +1,78 @@
+// Scan and middle-insert speed of UnrolledList
+// against LinkedList and Array.
+
+#include "../include/unrolledList.h"
+#include "../../Regular/include/linkedList.h"
+#include "../../../../Dynamic-Array/include/array.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+template<typename Func>
+static void run(const char* name, Func func)
+{
+    using namespace std::chrono;
+
+    auto start = high_resolution_clock::now();
+    func();
+    auto finish = high_resolution_clock::now();
+    auto time = duration_cast<microseconds>(finish - start);
+    std::cout << name << ": " << (long double) time.count() / 1000 << " ms\n";
+}
+
+template<typename List>
+static long scan(const List& list, int rounds)
+{
+    long sum = 0;
+    for (int round = 0; round < rounds; round++)
+        for (long element : list)
+            sum += element;
+    return sum;
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1 ? std::stoi(argv[1]) : 100000);
+    const int inserts = 2000;
+    const int rounds = 20;
+
+    LinkedList<long> linked;
+    UnrolledList<long> unrolled;
+    Array<long> array;
+    for (int i = 0; i < n; i++)
+    {
+        linked.append(i);
+        unrolled.append(i);
+        array.push(i);
+    }
+
+    // Same positions for every container.
+    int* positions = new int[inserts];
+    std::srand(1);
+    for (int i = 0; i < inserts; i++)
+        positions[i] = std::rand() % (n + i);
+
+    run("Middle inserts (LinkedList)", [&]() {
+        for (int i = 0; i < inserts; i++)
+            linked.insert(i, positions[i]);
+    });
+    run("Middle inserts (UnrolledList)", [&]() {
+        for (int i = 0; i < inserts; i++)
+            unrolled.insert(i, positions[i]);
+    });
+    run("Middle inserts (Array)", [&]() {
+        for (int i = 0; i < inserts; i++)
+            array.insert(i, positions[i]);
+    });
+
+    long sums[3] = {};
+    run("Scans (LinkedList)", [&]() { sums[0] = scan(linked, rounds); });
+    run("Scans (UnrolledList)", [&]() { sums[1] = scan(unrolled, rounds); });
+    run("Scans (Array)", [&]() { sums[2] = scan(array, rounds); });
+    std::cout << "Checksums match: "
+        << ((sums[0] == sums[1]) && (sums[1] == sums[2]) ? "true" : "false") << '\n';
+
+    delete[] positions;
+    return 0;
+}
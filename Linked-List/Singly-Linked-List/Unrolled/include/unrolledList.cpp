@@ -0,0 +1 @@
+#include "unrolledList.h"
\ No newline at end of file
@@ -0,0 +1,672 @@
+/*  An unrolled linked list: each node holds up to N elements in a small inline array.
+*   Same interface as LinkedList, but a scan touches one node per N elements instead of one per element,
+*   and an insert only shifts elements within a single node.
+*   A full node is split in half; a node that drops below half full is merged with its successor when they fit.
+*   Unlike LinkedList, front(), back(), at() and get() return a pointer to the element itself (there is no
+*   per-element node to hand out).
+*/
+
+#pragma once
+#include "../../../../Allocator/include/allocator.h"
+#include "../../../../Dynamic-Array/include/relocatable.h"
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#define UNROLLTEMP template<typename T, size_t N>
+
+// Only the first count elements are constructed.
+UNROLLTEMP
+struct UnrolledNode
+{
+    UnrolledNode<T, N>* next;
+    int count;
+    alignas(T) unsigned char buffer[N * sizeof(T)];
+
+    UnrolledNode() : next(nullptr), count(0) {}
+    T* items() { return reinterpret_cast<T*>(buffer); }
+    const T* items() const { return reinterpret_cast<const T*>(buffer); }
+};
+
+template<typename T, size_t N = 16>
+class UnrolledList
+{
+    static_assert(N >= 2, "UnrolledList needs room for at least 2 elements per node.");
+
+    private:
+        using Node = UnrolledNode<T, N>;
+
+        Node* head;
+        Node* tail;
+        int listLength;
+        // Every node comes from (and goes back to) here.
+        Allocator* alloc;
+
+        Node* newNode();
+        void freeNode(Node* node);
+        void clear();
+        // Moves the upper half of node into a new node after it.
+        void split(Node* node);
+        // Pulls next's elements into node and frees next.
+        void absorbNext(Node* node);
+        // Finds the node holding position and turns position
+        // into an index within that node.
+        Node* locate(int& position, Node** previous) const;
+
+        // Moves count elements from source to destination
+        // (overlap allowed); the source slots end up raw.
+        static void relocate(T* destination, T* source, int count);
+
+    public:
+        UnrolledList();
+        explicit UnrolledList(Allocator* alloc);
+        UnrolledList(const UnrolledList& other);
+        UnrolledList& operator=(const UnrolledList& other);
+        UnrolledList(UnrolledList&& other);
+        UnrolledList& operator=(UnrolledList&& other);
+        ~UnrolledList();
+
+        int length() const;
+        // Number of nodes in use.
+        int nodes() const;
+        Allocator* allocator() const;
+        T* front();
+        T* back();
+
+        // Add new element.
+
+        void prepend(T object);
+        void append(T object);
+        void insert(T object, int position);
+
+        // Find an element.
+
+        int position(const T& object, int start = 0) const;
+
+        // Remove element(s).
+
+        T erase(int position);
+        void remove(const T& object);
+        T pop();
+        void popn(int n);
+
+        // Check for and retrieve elements.
+
+        bool has(const T& object) const;
+        T* at(int position) const;
+        T* get(const T& object) const;
+
+        // Manage list.
+
+        void merge(const UnrolledList& other);
+
+        class iterator
+        {
+            private:
+                Node* node;
+                int index;
+
+            public:
+                iterator(Node* node, int index = 0);
+
+                T& operator*() const;
+                iterator& operator++();
+                iterator operator++(int);
+                bool operator==(const iterator& other) const;
+                bool operator!=(const iterator& other) const;
+        };
+
+        class const_iterator
+        {
+            private:
+                const Node* node;
+                int index;
+
+            public:
+                const_iterator(const Node* node, int index = 0);
+
+                const T& operator*() const;
+                const_iterator& operator++();
+                const_iterator operator++(int);
+                bool operator==(const const_iterator& other) const;
+                bool operator!=(const const_iterator& other) const;
+        };
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+};
+
+// Nodes don't point back at the list object.
+UNROLLTEMP
+struct isRelocatable<UnrolledList<T, N>> : std::true_type {};
+
+UNROLLTEMP
+UnrolledList<T, N>::UnrolledList() :
+    head(nullptr), tail(nullptr), listLength(0), alloc(defaultAllocator()) {}
+
+UNROLLTEMP
+UnrolledList<T, N>::UnrolledList(Allocator* alloc) :
+    head(nullptr), tail(nullptr), listLength(0), alloc(alloc) {}
+
+UNROLLTEMP
+typename UnrolledList<T, N>::Node* UnrolledList<T, N>::newNode()
+{
+    void* memory = alloc->allocate(sizeof(Node), alignof(Node));
+    return new (memory) Node();
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::freeNode(Node* node)
+{
+    alloc->deallocate(node, sizeof(Node), alignof(Node));
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::clear()
+{
+    // Same shortcut as LinkedList: let the allocator
+    // reclaim everything at once.
+    if (!(std::is_trivially_destructible_v<T> && alloc->releasesInBulk()))
+    {
+        Node* node = head;
+        while (node != nullptr)
+        {
+            Node* next = node->next;
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (int i = 0; i < node->count; i++)
+                    node->items()[i].~T();
+            }
+            freeNode(node);
+            node = next;
+        }
+    }
+
+    head = nullptr;
+    tail = nullptr;
+    listLength = 0;
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::relocate(T* destination, T* source, int count)
+{
+    if ((count <= 0) || (destination == source))
+        return;
+
+    if constexpr (isRelocatable_v<T>)
+        std::memmove((void*) destination, (void*) source, count * sizeof(T));
+    else if (destination < source)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            new (destination + i) T(std::move(source[i]));
+            source[i].~T();
+        }
+    }
+    else
+    {
+        // Walk backwards so nothing is overwritten before it moves.
+        for (int i = count - 1; i >= 0; i--)
+        {
+            new (destination + i) T(std::move(source[i]));
+            source[i].~T();
+        }
+    }
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::split(Node* node)
+{
+    Node* second = newNode();
+    int half = node->count / 2;
+
+    relocate(second->items(), node->items() + half, node->count - half);
+    second->count = node->count - half;
+    node->count = half;
+
+    second->next = node->next;
+    node->next = second;
+    if (tail == node)
+        tail = second;
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::absorbNext(Node* node)
+{
+    Node* next = node->next;
+    relocate(node->items() + node->count, next->items(), next->count);
+    node->count += next->count;
+
+    node->next = next->next;
+    if (tail == next)
+        tail = node;
+    freeNode(next);
+}
+
+UNROLLTEMP
+typename UnrolledList<T, N>::Node* UnrolledList<T, N>::locate(int& position, Node** previous) const
+{
+    Node* before = nullptr;
+    Node* node = head;
+    // Skips whole nodes at a time.
+    while ((node != nullptr) && (position >= node->count))
+    {
+        position -= node->count;
+        before = node;
+        node = node->next;
+    }
+
+    if (previous != nullptr)
+        *previous = before;
+    return node;
+}
+
+UNROLLTEMP
+UnrolledList<T, N>::UnrolledList(const UnrolledList& other) :
+    head(nullptr), tail(nullptr), listLength(0), alloc(other.alloc)
+{
+    for (const T& element : other)
+        this->append(element);
+}
+
+UNROLLTEMP
+UnrolledList<T, N>& UnrolledList<T, N>::operator=(const UnrolledList& other)
+{
+    if (this != &other)
+    {
+        this->clear();
+        for (const T& element : other)
+            this->append(element);
+    }
+
+    return *this;
+}
+
+UNROLLTEMP
+UnrolledList<T, N>::UnrolledList(UnrolledList&& other) :
+    head(other.head), tail(other.tail),
+    listLength(other.listLength), alloc(other.alloc)
+{
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.listLength = 0;
+}
+
+UNROLLTEMP
+UnrolledList<T, N>& UnrolledList<T, N>::operator=(UnrolledList&& other)
+{
+    if (this != &other)
+    {
+        this->clear();
+
+        // The nodes belong to other's allocator.
+        this->head = other.head;
+        this->tail = other.tail;
+        this->listLength = other.listLength;
+        this->alloc = other.alloc;
+
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.listLength = 0;
+    }
+
+    return *this;
+}
+
+UNROLLTEMP
+UnrolledList<T, N>::~UnrolledList()
+{
+    clear();
+}
+
+UNROLLTEMP
+int UnrolledList<T, N>::length() const
+{
+    return listLength;
+}
+
+UNROLLTEMP
+int UnrolledList<T, N>::nodes() const
+{
+    int nodes = 0;
+    for (Node* node = head; node != nullptr; node = node->next)
+        nodes++;
+    return nodes;
+}
+
+UNROLLTEMP
+Allocator* UnrolledList<T, N>::allocator() const
+{
+    return alloc;
+}
+
+UNROLLTEMP
+T* UnrolledList<T, N>::front()
+{
+    return (head == nullptr ? nullptr : head->items());
+}
+
+UNROLLTEMP
+T* UnrolledList<T, N>::back()
+{
+    return (tail == nullptr ? nullptr : tail->items() + tail->count - 1);
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::prepend(T object)
+{
+    if ((head == nullptr) || (head->count == (int) N))
+    {
+        Node* node = newNode();
+        node->next = head;
+        head = node;
+        if (tail == nullptr) // Was empty.
+            tail = node;
+    }
+
+    relocate(head->items() + 1, head->items(), head->count);
+    new (head->items()) T(std::move(object));
+    head->count++;
+    listLength++;
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::append(T object)
+{
+    if ((tail == nullptr) || (tail->count == (int) N))
+    {
+        Node* node = newNode();
+        if (head == nullptr) // Empty list.
+            head = node;
+        else
+            tail->next = node;
+        tail = node;
+    }
+
+    new (tail->items() + tail->count) T(std::move(object));
+    tail->count++;
+    listLength++;
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::insert(T object, int position)
+{
+    if ((position < 0) ||
+        ((position != 0) && (position >= listLength)))
+            return; // Put error-handling here.
+
+    // Same rule as LinkedList: position 0
+    // is allowed on an empty list.
+    if (head == nullptr)
+    {
+        prepend(std::move(object));
+        return;
+    }
+
+    Node* node = locate(position, nullptr);
+    if (node->count == (int) N)
+    {
+        split(node);
+        if (position > node->count)
+        {
+            position -= node->count;
+            node = node->next;
+        }
+    }
+
+    T* items = node->items();
+    relocate(items + position + 1, items + position, node->count - position);
+    new (items + position) T(std::move(object));
+    node->count++;
+    listLength++;
+}
+
+UNROLLTEMP
+int UnrolledList<T, N>::position(const T& object, int start) const
+{
+    if ((start < 0) || (start >= listLength))
+        return -1; // Put error-handling here.
+
+    int index = start;
+    Node* node = locate(index, nullptr);
+    int position = start - index;
+
+    for (; node != nullptr; node = node->next)
+    {
+        const T* items = node->items();
+        for (; index < node->count; index++)
+        {
+            if (items[index] == object)
+                return position + index;
+        }
+        position += node->count;
+        index = 0;
+    }
+
+    return -1;
+}
+
+UNROLLTEMP
+T UnrolledList<T, N>::erase(int position)
+{
+    if ((position < 0) || (position >= listLength))
+        throw std::out_of_range("Invalid position value.");
+
+    Node* previous = nullptr;
+    Node* node = locate(position, &previous);
+
+    T* items = node->items();
+    T element = std::move(items[position]);
+    items[position].~T();
+    relocate(items + position, items + position + 1, node->count - position - 1);
+    node->count--;
+    listLength--;
+
+    if (node->count == 0)
+    {
+        if (previous == nullptr) // Removing the head.
+            head = node->next;
+        else
+            previous->next = node->next;
+        if (tail == node)
+            tail = previous;
+        freeNode(node);
+    }
+    else if ((node->count < (int) N / 2) && (node->next != nullptr) &&
+        (node->count + node->next->count <= (int) N))
+        absorbNext(node);
+
+    return element;
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::remove(const T& object)
+{
+    int pos = position(object);
+    if (pos != -1)
+        erase(pos);
+}
+
+UNROLLTEMP
+T UnrolledList<T, N>::pop()
+{
+    return erase(listLength - 1);
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::popn(int n)
+{
+    while (n > 0)
+    {
+        pop();
+        n--;
+    }
+}
+
+UNROLLTEMP
+bool UnrolledList<T, N>::has(const T& object) const
+{
+    return (position(object) != -1);
+}
+
+UNROLLTEMP
+T* UnrolledList<T, N>::at(int position) const
+{
+    if ((position < 0) || (position >= listLength))
+        return nullptr; // Put error-handling here.
+
+    Node* node = locate(position, nullptr);
+    return node->items() + position;
+}
+
+UNROLLTEMP
+T* UnrolledList<T, N>::get(const T& object) const
+{
+    int pos = position(object);
+    if (pos == -1)
+        return nullptr;
+
+    return this->at(pos);
+}
+
+UNROLLTEMP
+void UnrolledList<T, N>::merge(const UnrolledList& other)
+{
+    // Copy the count first, in case other is this list.
+    int count = other.listLength;
+    const_iterator it = other.begin();
+    for (int i = 0; i < count; i++, ++it)
+        this->append(*it);
+}
+
+// Iterator.
+
+#define UnrolledIter UnrolledList<T, N>::iterator
+
+UNROLLTEMP
+UnrolledIter::iterator(Node* node, int index) :
+    node(node), index(index) {}
+
+UNROLLTEMP
+T& UnrolledIter::operator*() const
+{
+    return node->items()[index];
+}
+
+UNROLLTEMP
+typename UnrolledIter& UnrolledIter::operator++()
+{
+    if (++index == node->count)
+    {
+        node = node->next;
+        index = 0;
+    }
+    return *this;
+}
+
+UNROLLTEMP
+typename UnrolledIter UnrolledIter::operator++(int)
+{
+    iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+UNROLLTEMP
+bool UnrolledIter::operator==(const iterator& other) const
+{
+    return ((this->node == other.node) && (this->index == other.index));
+}
+
+UNROLLTEMP
+bool UnrolledIter::operator!=(const iterator& other) const
+{
+    return !(*this == other);
+}
+
+UNROLLTEMP
+typename UnrolledIter UnrolledList<T, N>::begin()
+{
+    return iterator(head);
+}
+
+UNROLLTEMP
+typename UnrolledIter UnrolledList<T, N>::end()
+{
+    return iterator(nullptr);
+}
+
+// Constant iterator.
+
+#define constUnrolledIter UnrolledList<T, N>::const_iterator
+
+UNROLLTEMP
+constUnrolledIter::const_iterator(const Node* node, int index) :
+    node(node), index(index) {}
+
+UNROLLTEMP
+const T& constUnrolledIter::operator*() const
+{
+    return node->items()[index];
+}
+
+UNROLLTEMP
+typename constUnrolledIter& constUnrolledIter::operator++()
+{
+    if (++index == node->count)
+    {
+        node = node->next;
+        index = 0;
+    }
+    return *this;
+}
+
+UNROLLTEMP
+typename constUnrolledIter constUnrolledIter::operator++(int)
+{
+    const_iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+UNROLLTEMP
+bool constUnrolledIter::operator==(const const_iterator& other) const
+{
+    return ((this->node == other.node) && (this->index == other.index));
+}
+
+UNROLLTEMP
+bool constUnrolledIter::operator!=(const const_iterator& other) const
+{
+    return !(*this == other);
+}
+
+UNROLLTEMP
+typename constUnrolledIter UnrolledList<T, N>::begin() const
+{
+    return const_iterator(head);
+}
+
+UNROLLTEMP
+typename constUnrolledIter UnrolledList<T, N>::end() const
+{
+    return const_iterator(nullptr);
+}
+
+UNROLLTEMP
+typename constUnrolledIter UnrolledList<T, N>::cbegin() const
+{
+    return const_iterator(head);
+}
+
+UNROLLTEMP
+typename constUnrolledIter UnrolledList<T, N>::cend() const
+{
+    return const_iterator(nullptr);
+}
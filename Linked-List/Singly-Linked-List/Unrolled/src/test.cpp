@@ -0,0 +1,52 @@
+#include "../include/unrolledList.h"
+#include "../../General/nodePool.h"
+#include <iostream>
+#include <string>
+
+int main()
+{
+    // Small nodes so splitting and merging show up quickly.
+    UnrolledList<int, 4> list;
+
+    list.insert(1, 2); // Inserting at position 2 in empty list; doesn't do anything.
+    list.insert(1, 0); // Inserting at position 0 in empty list.
+    std::cout << *list.at(0) << '\n';
+    list.pop();
+
+    for (int i = 0; i < 10; i++)
+        list.append(i + 1);
+    std::cout << "Size: " << list.length() << ", nodes: " << list.nodes() << '\n';
+
+    list.insert(100, 1); // Splits the first node.
+    list.insert(200, 5);
+    list.prepend(0);
+    std::cout << "After insertion (nodes: " << list.nodes() << "):\n";
+    for (const auto& element : list)
+        std::cout << element << ' ';
+    std::cout << '\n';
+
+    std::cout << "Position of 7: " << list.position(7) << '\n';
+    std::cout << "List has 200: " << (list.has(200) ? "true" : "false") << '\n';
+    std::cout << "Erased: " << list.erase(2) << '\n';
+    list.remove(200);
+    list.remove(5);
+    list.remove(6);
+    std::cout << "After erasing (nodes: " << list.nodes() << "):\n";
+    for (const auto& element : list)
+        std::cout << element << ' ';
+    std::cout << '\n';
+    std::cout << "Front: " << *list.front() << ", back: " << *list.back() << '\n';
+
+    UnrolledList<std::string, 4> words;
+    words.append("unrolled");
+    words.append("linked");
+    words.prepend("an");
+    words.insert("small", 1);
+    UnrolledList<std::string, 4> moreWords = words;
+    words.merge(moreWords);
+    for (const auto& word : words)
+        std::cout << word << ' ';
+    std::cout << "(" << words.length() << " words)\n";
+
+    return 0;
+}
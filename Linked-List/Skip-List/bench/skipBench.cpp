@@ -0,0 +1,66 @@
+// Ordered-set workload (insert, lookup, remove) on SkipList
+// against LinkedList's sortAdd/sortHas/sortRemove path.
+
+#include "../include/skipList.h"
+#include "../../Singly-Linked-List/Regular/include/linkedList.h"
+#include "../../../General/benchTimer.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std::chrono;
+
+static void compare(int n)
+{
+    int* keys = new int[n];
+    std::srand(n);
+    for (int i = 0; i < n; i++)
+        keys[i] = std::rand() % (n * 4);
+
+    std::cout << n << " elements:\n";
+    int found[2] = {};
+
+    LinkedList<int> list;
+    auto start = steady_clock::now();
+    for (int i = 0; i < n; i++)
+    {
+        if (!list.sortHas(keys[i]))
+            list.sortAdd(keys[i]);
+    }
+    std::cout << "  LinkedList add: " << elapsed(start) << " ms, ";
+    start = steady_clock::now();
+    for (int i = 0; i < n; i++)
+        found[0] += list.sortHas(i);
+    std::cout << "has: " << elapsed(start) << " ms, ";
+    start = steady_clock::now();
+    for (int i = 0; i < n; i += 2)
+        list.sortRemove(keys[i]);
+    std::cout << "remove: " << elapsed(start) << " ms\n";
+
+    SkipList<int> skip;
+    start = steady_clock::now();
+    for (int i = 0; i < n; i++)
+        skip.add(keys[i]);
+    std::cout << "  SkipList   add: " << elapsed(start) << " ms, ";
+    start = steady_clock::now();
+    for (int i = 0; i < n; i++)
+        found[1] += skip.has(i);
+    std::cout << "has: " << elapsed(start) << " ms, ";
+    start = steady_clock::now();
+    for (int i = 0; i < n; i += 2)
+        skip.remove(keys[i]);
+    std::cout << "remove: " << elapsed(start) << " ms\n";
+
+    std::cout << "  Same contents: "
+        << ((found[0] == found[1]) && (list.length() == skip.length()) ? "true" : "false") << '\n';
+    delete[] keys;
+}
+
+int main(int argc, char** argv)
+{
+    int largest = (argc > 1 ? std::stoi(argv[1]) : 20000);
+    for (int n = 1000; n <= largest; n *= 4)
+        compare(n);
+    return 0;
+}
@@ -0,0 +1 @@
+#include "skipList.h"
\ No newline at end of file
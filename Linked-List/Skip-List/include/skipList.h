@@ -0,0 +1,521 @@
+/*  A sorted set built as a skip list: a sorted singly linked list where every node also has a random
+*   number of extra "express" links that skip ahead, so add/has/remove/lowerBound are O(log n) expected
+*   (instead of LinkedList's linear sortAdd/sortHas/sortRemove).
+*   Order is given by compare(a, b), true if a has to come before b; elements that compare equal are
+*   treated as duplicates and only kept once.
+*/
+
+#pragma once
+#include "../../../Allocator/include/allocator.h"
+#include "../../../Dynamic-Array/include/relocatable.h"
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#define SKIPTEMP template<typename T, typename Compare>
+
+// Like ListNode, but with height next pointers (stored right
+// after the node). next[0] links every node in order.
+template<typename T>
+struct SkipNode
+{
+    T object;
+    int height;
+    SkipNode<T>** next;
+
+    SkipNode(T object, int height);
+};
+
+template<typename T>
+SkipNode<T>::SkipNode(T object, int height) :
+    object(std::move(object)), height(height),
+    next(reinterpret_cast<SkipNode<T>**>(this + 1))
+{
+    for (int i = 0; i < height; i++)
+        next[i] = nullptr;
+}
+
+template<typename T, typename Compare = std::less<T>>
+class SkipList
+{
+    public:
+        // Enough for far more elements than fit in memory
+        // with a 1/4 chance of going up a level.
+        static constexpr int MAX_LEVEL = 24;
+
+    private:
+        // The head links; heads[i] is the first node of level i.
+        SkipNode<T>* heads[MAX_LEVEL];
+        int listLength;
+        int levels; // Levels currently in use.
+        uint64_t seed;
+        Compare compare;
+        // Every node comes from (and goes back to) here.
+        Allocator* alloc;
+
+        SkipNode<T>* newNode(T object, int height);
+        void freeNode(SkipNode<T>* node);
+        void clear();
+        int randomHeight();
+        bool equal(const T& first, const T& second) const;
+        // Fills update[i] with the link array holding the last
+        // level-i link to a node before object.
+        void predecessors(const T& object, SkipNode<T>** update[]) const;
+        // First node not before object (or nullptr).
+        SkipNode<T>* lowerNode(const T& object) const;
+        // First node after object (or nullptr).
+        SkipNode<T>* upperNode(const T& object) const;
+        SkipNode<T>** links() const;
+
+    public:
+        SkipList();
+        explicit SkipList(Allocator* alloc, Compare compare = Compare());
+        SkipList(const SkipList& other);
+        SkipList& operator=(const SkipList& other);
+        SkipList(SkipList&& other);
+        SkipList& operator=(SkipList&& other);
+        ~SkipList();
+
+        int length() const;
+        Allocator* allocator() const;
+        // Smallest and largest elements (nullptr if empty).
+        const T* front() const;
+        const T* back() const;
+
+        // Returns false (and doesn't add it) if an
+        // equal element is already in the list.
+        bool add(T object);
+        bool has(const T& object) const;
+        const T* get(const T& object) const;
+        // Returns false if there was nothing to remove.
+        bool remove(const T& object);
+        T pop(); // Removes the smallest element.
+
+        // Elements can't be changed in place (that could
+        // break the order), so both iterators are read-only.
+        class iterator
+        {
+            private:
+                const SkipNode<T>* ptr;
+
+            public:
+                iterator(const SkipNode<T>* ptr);
+
+                const T& operator*() const;
+                const T* operator->() const;
+                iterator& operator++();
+                iterator operator++(int);
+                bool operator==(const iterator& other) const;
+                bool operator!=(const iterator& other) const;
+        };
+        using const_iterator = iterator;
+
+        // A begin()/end() pair for range-based for loops.
+        struct Range
+        {
+            iterator first;
+            iterator last;
+
+            iterator begin() const { return first; }
+            iterator end() const { return last; }
+        };
+
+        // First element not before object.
+        iterator lowerBound(const T& object) const;
+        // First element after object.
+        iterator upperBound(const T& object) const;
+        // Elements in [low, high].
+        Range range(const T& low, const T& high) const;
+
+        iterator begin() const;
+        iterator end() const;
+        iterator cbegin() const;
+        iterator cend() const;
+};
+
+// Nodes only point at other nodes.
+SKIPTEMP
+struct isRelocatable<SkipList<T, Compare>> : std::true_type {};
+
+SKIPTEMP
+SkipList<T, Compare>::SkipList() :
+    SkipList(defaultAllocator()) {}
+
+SKIPTEMP
+SkipList<T, Compare>::SkipList(Allocator* alloc, Compare compare) :
+    heads{}, listLength(0), levels(1),
+    seed(0x9E3779B97F4A7C15ull), compare(compare), alloc(alloc) {}
+
+SKIPTEMP
+SkipNode<T>* SkipList<T, Compare>::newNode(T object, int height)
+{
+    size_t size = sizeof(SkipNode<T>) + height * sizeof(SkipNode<T>*);
+    void* memory = alloc->allocate(size, alignof(SkipNode<T>));
+    return new (memory) SkipNode<T>(std::move(object), height);
+}
+
+SKIPTEMP
+void SkipList<T, Compare>::freeNode(SkipNode<T>* node)
+{
+    size_t size = sizeof(SkipNode<T>) + node->height * sizeof(SkipNode<T>*);
+    node->~SkipNode<T>();
+    alloc->deallocate(node, size, alignof(SkipNode<T>));
+}
+
+SKIPTEMP
+void SkipList<T, Compare>::clear()
+{
+    // Same shortcut as LinkedList: let the allocator
+    // reclaim everything at once.
+    if (!(std::is_trivially_destructible_v<T> && alloc->releasesInBulk()))
+    {
+        SkipNode<T>* node = heads[0];
+        while (node != nullptr)
+        {
+            SkipNode<T>* next = node->next[0];
+            freeNode(node);
+            node = next;
+        }
+    }
+
+    for (int i = 0; i < MAX_LEVEL; i++)
+        heads[i] = nullptr;
+    listLength = 0;
+    levels = 1;
+}
+
+SKIPTEMP
+int SkipList<T, Compare>::randomHeight()
+{
+    // xorshift64; each pair of bits is a 1/4 chance to go up.
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+
+    uint64_t bits = seed;
+    int height = 1;
+    while ((height < MAX_LEVEL) && ((bits & 3) == 0))
+    {
+        height++;
+        bits >>= 2;
+    }
+    return height;
+}
+
+SKIPTEMP
+bool SkipList<T, Compare>::equal(const T& first, const T& second) const
+{
+    return (!compare(first, second) && !compare(second, first));
+}
+
+SKIPTEMP
+SkipNode<T>** SkipList<T, Compare>::links() const
+{
+    // The heads act as the link array of a node before the first.
+    return const_cast<SkipNode<T>**>(heads);
+}
+
+SKIPTEMP
+void SkipList<T, Compare>::predecessors(const T& object, SkipNode<T>** update[]) const
+{
+    SkipNode<T>** current = links();
+    for (int i = levels - 1; i >= 0; i--)
+    {
+        while ((current[i] != nullptr) && compare(current[i]->object, object))
+            current = current[i]->next;
+        update[i] = current;
+    }
+}
+
+SKIPTEMP
+SkipNode<T>* SkipList<T, Compare>::lowerNode(const T& object) const
+{
+    SkipNode<T>** current = links();
+    for (int i = levels - 1; i >= 0; i--)
+    {
+        while ((current[i] != nullptr) && compare(current[i]->object, object))
+            current = current[i]->next;
+    }
+    return current[0];
+}
+
+SKIPTEMP
+SkipNode<T>* SkipList<T, Compare>::upperNode(const T& object) const
+{
+    SkipNode<T>** current = links();
+    for (int i = levels - 1; i >= 0; i--)
+    {
+        while ((current[i] != nullptr) && !compare(object, current[i]->object))
+            current = current[i]->next;
+    }
+    return current[0];
+}
+
+// The copy uses the same allocator as other.
+SKIPTEMP
+SkipList<T, Compare>::SkipList(const SkipList& other) :
+    SkipList(other.alloc, other.compare)
+{
+    for (const T& element : other)
+        this->add(element);
+}
+
+SKIPTEMP
+SkipList<T, Compare>& SkipList<T, Compare>::operator=(const SkipList& other)
+{
+    if (this != &other)
+    {
+        this->clear();
+        for (const T& element : other)
+            this->add(element);
+    }
+
+    return *this;
+}
+
+SKIPTEMP
+SkipList<T, Compare>::SkipList(SkipList&& other) :
+    SkipList(other.alloc, other.compare)
+{
+    *this = std::move(other);
+}
+
+SKIPTEMP
+SkipList<T, Compare>& SkipList<T, Compare>::operator=(SkipList&& other)
+{
+    if (this != &other)
+    {
+        this->clear();
+
+        // The nodes belong to other's allocator.
+        for (int i = 0; i < MAX_LEVEL; i++)
+        {
+            this->heads[i] = other.heads[i];
+            other.heads[i] = nullptr;
+        }
+        this->listLength = other.listLength;
+        this->levels = other.levels;
+        this->compare = other.compare;
+        this->alloc = other.alloc;
+
+        other.listLength = 0;
+        other.levels = 1;
+    }
+
+    return *this;
+}
+
+SKIPTEMP
+SkipList<T, Compare>::~SkipList()
+{
+    clear();
+}
+
+SKIPTEMP
+int SkipList<T, Compare>::length() const
+{
+    return listLength;
+}
+
+SKIPTEMP
+Allocator* SkipList<T, Compare>::allocator() const
+{
+    return alloc;
+}
+
+SKIPTEMP
+const T* SkipList<T, Compare>::front() const
+{
+    return (heads[0] == nullptr ? nullptr : &(heads[0]->object));
+}
+
+SKIPTEMP
+const T* SkipList<T, Compare>::back() const
+{
+    // Ride the express links as far as they go.
+    SkipNode<T>* const* current = heads;
+    const SkipNode<T>* last = nullptr;
+    for (int i = levels - 1; i >= 0; i--)
+    {
+        while (current[i] != nullptr)
+        {
+            last = current[i];
+            current = current[i]->next;
+        }
+    }
+    return (last == nullptr ? nullptr : &(last->object));
+}
+
+SKIPTEMP
+bool SkipList<T, Compare>::add(T object)
+{
+    SkipNode<T>** update[MAX_LEVEL];
+    predecessors(object, update);
+
+    SkipNode<T>* next = update[0][0];
+    if ((next != nullptr) && equal(next->object, object))
+        return false;
+
+    int height = randomHeight();
+    for (; levels < height; levels++)
+        update[levels] = links();
+
+    SkipNode<T>* node = newNode(std::move(object), height);
+    for (int i = 0; i < height; i++)
+    {
+        node->next[i] = update[i][i];
+        update[i][i] = node;
+    }
+
+    listLength++;
+    return true;
+}
+
+SKIPTEMP
+bool SkipList<T, Compare>::has(const T& object) const
+{
+    return (get(object) != nullptr);
+}
+
+SKIPTEMP
+const T* SkipList<T, Compare>::get(const T& object) const
+{
+    SkipNode<T>* node = lowerNode(object);
+    if ((node == nullptr) || compare(object, node->object))
+        return nullptr;
+    return &(node->object);
+}
+
+SKIPTEMP
+bool SkipList<T, Compare>::remove(const T& object)
+{
+    SkipNode<T>** update[MAX_LEVEL];
+    predecessors(object, update);
+
+    SkipNode<T>* node = update[0][0];
+    if ((node == nullptr) || !equal(node->object, object))
+        return false;
+
+    for (int i = 0; i < node->height; i++)
+        update[i][i] = node->next[i];
+    // Drop levels that are empty now.
+    while ((levels > 1) && (heads[levels - 1] == nullptr))
+        levels--;
+
+    freeNode(node);
+    listLength--;
+    return true;
+}
+
+SKIPTEMP
+T SkipList<T, Compare>::pop()
+{
+    SkipNode<T>* node = heads[0];
+    if (node == nullptr)
+        throw std::out_of_range("Cannot pop from an empty list.");
+
+    // The first node is first on every level it's on.
+    for (int i = 0; i < node->height; i++)
+        heads[i] = node->next[i];
+    while ((levels > 1) && (heads[levels - 1] == nullptr))
+        levels--;
+
+    T element = std::move(node->object);
+    freeNode(node);
+    listLength--;
+    return element;
+}
+
+SKIPTEMP
+typename SkipList<T, Compare>::iterator SkipList<T, Compare>::lowerBound(const T& object) const
+{
+    return iterator(lowerNode(object));
+}
+
+SKIPTEMP
+typename SkipList<T, Compare>::iterator SkipList<T, Compare>::upperBound(const T& object) const
+{
+    return iterator(upperNode(object));
+}
+
+SKIPTEMP
+typename SkipList<T, Compare>::Range SkipList<T, Compare>::range(const T& low, const T& high) const
+{
+    if (compare(high, low)) // Empty range.
+        return Range{end(), end()};
+    return Range{lowerBound(low), upperBound(high)};
+}
+
+// Iterator.
+
+#define SkipIter SkipList<T, Compare>::iterator
+
+SKIPTEMP
+SkipIter::iterator(const SkipNode<T>* ptr) :
+    ptr(ptr) {}
+
+SKIPTEMP
+const T& SkipIter::operator*() const
+{
+    return ptr->object;
+}
+
+SKIPTEMP
+const T* SkipIter::operator->() const
+{
+    return &(ptr->object);
+}
+
+SKIPTEMP
+typename SkipIter& SkipIter::operator++()
+{
+    ptr = ptr->next[0];
+    return *this;
+}
+
+SKIPTEMP
+typename SkipIter SkipIter::operator++(int)
+{
+    iterator temp = *this;
+    ptr = ptr->next[0];
+    return temp;
+}
+
+SKIPTEMP
+bool SkipIter::operator==(const iterator& other) const
+{
+    return (this->ptr == other.ptr);
+}
+
+SKIPTEMP
+bool SkipIter::operator!=(const iterator& other) const
+{
+    return (this->ptr != other.ptr);
+}
+
+SKIPTEMP
+typename SkipIter SkipList<T, Compare>::begin() const
+{
+    return iterator(heads[0]);
+}
+
+SKIPTEMP
+typename SkipIter SkipList<T, Compare>::end() const
+{
+    return iterator(nullptr);
+}
+
+SKIPTEMP
+typename SkipIter SkipList<T, Compare>::cbegin() const
+{
+    return iterator(heads[0]);
+}
+
+SKIPTEMP
+typename SkipIter SkipList<T, Compare>::cend() const
+{
+    return iterator(nullptr);
+}
@@ -0,0 +1,53 @@
+#include "../include/skipList.h"
+#include "../../../Allocator/include/arenaAllocator.h"
+#include <functional>
+#include <iostream>
+#include <string>
+
+int main()
+{
+    SkipList<int> list;
+
+    for (int i = 20; i > 0; i -= 2)
+        list.add(i);
+    std::cout << "Added 4 again: " << (list.add(4) ? "true" : "false") << '\n';
+    std::cout << "Size: " << list.length() << '\n';
+
+    for (const auto& element : list)
+        std::cout << element << ' ';
+    std::cout << '\n';
+
+    std::cout << "List has 8: " << (list.has(8) ? "true" : "false") << '\n';
+    std::cout << "List has 9: " << (list.has(9) ? "true" : "false") << '\n';
+    std::cout << "Lower bound of 9: " << *list.lowerBound(9) << '\n';
+    std::cout << "Upper bound of 10: " << *list.upperBound(10) << '\n';
+    std::cout << "Front: " << *list.front() << ", back: " << *list.back() << '\n';
+
+    std::cout << "Range [5, 13]: ";
+    for (const auto& element : list.range(5, 13))
+        std::cout << element << ' ';
+    std::cout << '\n';
+
+    list.remove(10);
+    list.remove(11); // Not in the list; doesn't do anything.
+    std::cout << "Popped: " << list.pop() << '\n';
+    std::cout << "After removing (size " << list.length() << "):\n";
+    for (const auto& element : list)
+        std::cout << element << ' ';
+    std::cout << '\n';
+
+    // Descending order, with nodes from an arena.
+    ArenaAllocator arena;
+    SkipList<std::string, std::greater<std::string>> words(&arena);
+    words.add("skip");
+    words.add("list");
+    words.add("ordered");
+    words.add("set");
+    SkipList<std::string, std::greater<std::string>> copy = words;
+    copy.remove("set");
+    for (const auto& word : words)
+        std::cout << word << ' ';
+    std::cout << "(copy has " << copy.length() << " words)\n";
+
+    return 0;
+}
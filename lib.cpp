@@ -1,5 +1,14 @@
+#include "allocator.h"
+#include "arenaAllocator.h"
+#include "poolAllocator.h"
 #include "array.h"
+#include "smallArray.h"
 #include "chainTable.h"
+#include "concurrentTable.h"
 #include "linearTable.h"
 #include "robinTable.h"
-#include "linkedList.h"
\ No newline at end of file
+#include "swissTable.h"
+#include "linkedList.h"
+#include "unrolledList.h"
+#include "skipList.h"
+#include "compactList.h"
\ No newline at end of file